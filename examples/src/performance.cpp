@@ -431,6 +431,26 @@ struct ParseFormTest {
 	}
 };
 
+//count the monomials allocated by repeated products of forms, with and without hash-consing
+void MeasureLambdaMemory(int N)
+{
+	srand(0);
+	ConcreteManifold M(N);
+	ex form;
+	for (int i=0;i<N;++i)
+		form+=(rand()%10-5)*M.e()[rand()%N]*M.e()[rand()%N];
+	for (bool hash_consing : {false,true}) {
+		SetLambdaHashConsing(hash_consing);
+		LambdaTableStatistics before=GetLambdaTableStatistics<VectorField>();
+		ex product=1;
+		for (int k=0;k<3;++k) product=(product*form).expand();
+		LambdaTableStatistics after=GetLambdaTableStatistics<VectorField>();
+		cout<<"Lambda monomials, parameter "<<N<<", hash-consing "<<(hash_consing? "on" : "off")<<": "
+			<<after.created-before.created<<" allocated, "<<after.reused-before.reused<<" shared"<<endl;
+	}
+	SetLambdaHashConsing(true);
+}
+
 int main()
 {
 
@@ -514,6 +534,9 @@ int main()
 	MEASURE(matrixTest<matrix>, 1, 1193580000);
 	MEASURE(matrixTest<GinacLinAlgAlgorithms::InverseMatrix>, 0, 1027710);
 	MEASURE(matrixTest<GinacLinAlgAlgorithms::InverseMatrix>, 1, 1210050000);
+	cout<<"Testing the memory usage of some Wedge functions:"<<endl;
+	MeasureLambdaMemory(10);
+	MeasureLambdaMemory(20);
 	return 0;
 }
 
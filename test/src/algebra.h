@@ -33,6 +33,7 @@
 #include "wedge/linearalgebra/linear.h"
 #include "wedge/linearalgebra/bilinearform.h"
 #include "wedge/linearalgebra/affinebasis.h"
+#include "wedge/linearalgebra/sparselinearsystem.h"
 #include "wedge/manifolds/concretemanifold.h"
 
 using namespace GiNaC;
@@ -647,6 +648,24 @@ public:
 		}
 	}
 
+	void testSparseLinearSystem() {
+		SparseLinearSystem system(4);
+		system.AddEquation(exvector{1,2,0,0});
+		system.AddEquation(exvector{2,4,0,0});
+		system.AddEquation(SparseLinearSystem::Row{{2,numeric(1,2)},{3,-1}});
+		TS_ASSERT_EQUALS(system.Rank(),2);
+		auto solutions=system.Solutions();
+		TS_ASSERT_EQUALS(solutions.size(),2);
+		for (auto& x: solutions) {
+			TS_ASSERT_EQUALS(x.size(),4);
+			TS_ASSERT_EQUALS(x[0]+2*x[1],0);
+			TS_ASSERT_EQUALS(x[2]/2-x[3],0);
+		}
+		TS_ASSERT(!SparseLinearSystem::IsCoefficient(sqrt(ex(2))));
+		TS_ASSERT_THROWS(system.AddEquation(exvector{sqrt(ex(2)),0,0,0}),InvalidArgument);
+		TS_ASSERT_THROWS(system.AddEquation(SparseLinearSystem::Row{{4,1}}),OutOfRange);
+	}
+
 	void testOperators()
 	{
 		ex r=symbol("r");
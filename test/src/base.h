@@ -25,6 +25,10 @@
 #include "wedge/base/expressions.h"
 #include "wedge/convenience/latex.h"
 #include "wedge/base/utilities.h"
+#include "wedge/base/parallel.h"
+#include "wedge/base/zerotest.h"
+#include "wedge/base/simplificationcache.h"
+#include "wedge/base/straightlineprogram.h"
 #include <cxxtest/TestSuite.h>
 #include "test.h"
 
@@ -274,4 +278,129 @@ public:
 	}
 };
 
+//test parallel.h
+class ParallelTestSuite : public CxxTest::TestSuite 
+{
+public:
+	void testParallelMap() {
+		symbol x("x"),y("y");
+		auto f=[&x,&y] (int i) {return ex{pow(x+i*y,i).expand()};};
+		lst symbols;
+		CollectSymbols(x+2*y,symbols);
+		TS_ASSERT_EQUALS(symbols.nops(),2);
+		exvector serial=ParallelMap(10,f,symbols);
+		SetParallelism(3);
+		exvector parallel=ParallelMap(10,f,symbols);
+		SetParallelism(1);
+		TS_ASSERT_EQUALS(serial.size(),10);
+		TS_ASSERT_EQUALS(serial,parallel);
+		TS_ASSERT_THROWS(SetParallelism(0),OutOfRange);
+	}
+};
+
+//test zerotest.h
+class ZeroTestSuite : public CxxTest::TestSuite 
+{
+public:
+	void testProbablyZero() {
+		symbol x("x"),y("y"),z("z");
+		ex big=numeric("123456789012345678901234567890")/numeric("987654321098765432109876543211");
+		TS_ASSERT(ProbablyZero(pow(x+big*y,5)-pow(x+big*y,3)*pow(x+big*y,2)));
+		TS_ASSERT(ProbablyZero(1/(x-y)+1/(y-x)));
+		TS_ASSERT(ProbablyZero((x*x-y*y)/(x-y)-x-y));
+		TS_ASSERT(!ProbablyZero(pow(x+y,3)-pow(x,3)-pow(y,3)));
+		TS_ASSERT(!ProbablyZero(big*z/(x*x+1)-big/(x*x+1)*z+numeric(1,1000000007)));
+		//unsupported expressions fall back to the exact test
+		TS_ASSERT(ProbablyZero(sqrt(x)*sqrt(x)*y-sqrt(x)*y*sqrt(x)));
+		TS_ASSERT(!ProbablyZero(sqrt(x)*y-y));
+	}
+	void testCoefficientIsZero() {
+		symbol x("x"),y("y");
+		TS_ASSERT_EQUALS(RandomizedZeroTesting(),0);
+		TS_ASSERT_THROWS(SetRandomizedZeroTesting(-1),OutOfRange);
+		ex zero=(x+y)*(x-y)/(x+2*y)-(x*x-y*y)/(x+2*y);
+		TS_ASSERT(CoefficientIsZero(zero));
+		TS_ASSERT(!CoefficientIsZero(zero+x/y));
+		SetRandomizedZeroTesting(3);
+		TS_ASSERT_EQUALS(RandomizedZeroTesting(),3);
+		TS_ASSERT(CoefficientIsZero(zero));
+		TS_ASSERT(!CoefficientIsZero(zero+x/y));
+		V v1(N.v(1)),v2(N.v(2));
+		TS_ASSERT_EQUALS(NormalForm<V>(zero*v1+x*v2),x*v2);
+		SetRandomizedZeroTesting(0);
+	}
+};
+
+//test simplificationcache.h
+class SimplificationCacheTestSuite : public CxxTest::TestSuite 
+{
+public:
+	void testCachedNormal() {
+		symbol x("x"),y("y");
+		ex e=(x*x-y*y)/(x-y), f=pow(x+y,4);
+		TS_ASSERT_EQUALS(SimplificationCacheBudget(),0);
+		auto before=GetSimplificationCacheStatistics();
+		TS_ASSERT_EQUALS(CachedNormal(e),e.normal());
+		TS_ASSERT_EQUALS(GetSimplificationCacheStatistics().misses,before.misses);
+		SetSimplificationCacheBudget(1<<20);
+		TS_ASSERT_EQUALS(CachedNormal(e),x+y);
+		TS_ASSERT_EQUALS(CachedNormal(e),x+y);
+		TS_ASSERT_EQUALS(CachedExpand(f),f.expand());
+		TS_ASSERT_EQUALS(CachedExpand(f),f.expand());
+		TS_ASSERT_EQUALS(CachedNormal(f),f.normal());
+		auto after=GetSimplificationCacheStatistics();
+		TS_ASSERT_EQUALS(after.hits,before.hits+2);
+		TS_ASSERT_EQUALS(after.misses,before.misses+3);
+		TS_ASSERT_EQUALS(after.entries,3);
+		TS_ASSERT(after.memory>0);
+		SetSimplificationCacheBudget(1);
+		after=GetSimplificationCacheStatistics();
+		TS_ASSERT_EQUALS(after.entries,0);
+		TS_ASSERT_EQUALS(after.memory,0);
+		TS_ASSERT_EQUALS(after.evictions,before.evictions+3);
+		TS_ASSERT_EQUALS(CachedNormal(e),x+y);
+		TS_ASSERT_EQUALS(GetSimplificationCacheStatistics().entries,0);
+		SetSimplificationCacheBudget(1<<20);
+		CachedNormal(e);
+		ClearSimplificationCache();
+		TS_ASSERT_EQUALS(GetSimplificationCacheStatistics().entries,0);
+		SetSimplificationCacheBudget(0);
+	}
+};
+
+//test straightlineprogram.h
+class StraightLineProgramTestSuite : public CxxTest::TestSuite 
+{
+public:
+	void testEvaluate() {
+		symbol x("x"),y("y");
+		StraightLineProgram program({x,y},{x*y+sin(x*y),pow(x,3)/y,sqrt(x),2+Pi});
+		TS_ASSERT_EQUALS(program.Variables(),2);
+		TS_ASSERT_EQUALS(program.Outputs(),4);
+		vector<double> points;
+		for (int p=0;p<100;++p) {
+			points.push_back(1+p*0.01);
+			points.push_back(2-p*0.01);
+		}
+		vector<double> values=program.Evaluate(points);
+		TS_ASSERT_EQUALS(values.size(),400);
+		for (int p=0;p<100;++p) {
+			double a=points[2*p], b=points[2*p+1];
+			TS_ASSERT_DELTA(values[4*p],a*b+std::sin(a*b),1e-12);
+			TS_ASSERT_DELTA(values[4*p+1],a*a*a/b,1e-12);
+			TS_ASSERT_DELTA(values[4*p+2],std::sqrt(a),1e-12);
+			TS_ASSERT_DELTA(values[4*p+3],2+M_PI,1e-12);
+		}
+		TS_ASSERT_THROWS(program.Evaluate(vector<double>{1,2,3}),WedgeException<std::invalid_argument>);
+		TS_ASSERT_EQUALS(StraightLineProgram({x,y},{x*y,sin(x*y),x*y}).Instructions(),2);
+		TS_ASSERT_THROWS(StraightLineProgram({x},{y}),InvalidArgument);
+
+		StraightLineProgram complex_program({x},{I*x+1});
+		TS_ASSERT_THROWS(complex_program.Evaluate(vector<double>{1}),WedgeException<std::invalid_argument>);
+		vector<complex<double>> z=complex_program.Evaluate(vector<complex<double>>{{2,0}});
+		TS_ASSERT_DELTA(z[0].real(),1,1e-12);
+		TS_ASSERT_DELTA(z[0].imag(),2,1e-12);
+	}
+};
+
 #endif /*BASE_H_*/
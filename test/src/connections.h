@@ -21,6 +21,7 @@
 #define CONNECTIONS_H_
 
 #include <cxxtest/TestSuite.h>
+#include <filesystem>
 #include "test.h"
 #include "wedge/structures/riemannianstructure.h"
 #include "wedge/structures/transversestructure.h"
@@ -30,6 +31,9 @@
 #include "wedge/connections/transverseconnection.h"
 #include "wedge/liealgebras/liegroup.h"
 #include "wedge/liealgebras/liesubgroup.h"
+#include "wedge/base/parallel.h"
+#include "wedge/base/persistence.h"
+#include "wedge/base/resultcache.h"
 #include "wedge/structures/gstructure.h"
 #include "wedge/manifolds/manifoldwith.h"
 #include "wedge/manifolds/coordinates.h"
@@ -616,6 +620,43 @@ public:
 	}
 
 
+	void testParallelCurvature() {
+		S3 M;
+		LeviCivitaConnection<true> leviCivita(&M,RiemannianStructure(&M,M.e()));
+		matrix R=leviCivita.CurvatureForm();
+		matrix ric=leviCivita.RicciAsMatrix();
+		SetParallelism(4);
+		TS_ASSERT_EQUALS(leviCivita.CurvatureForm(),R);
+		TS_ASSERT_EQUALS(leviCivita.RicciAsMatrix(),ric);
+		TS_ASSERT_EQUALS(leviCivita.Torsion(),ExVector(M.Dimension()));
+		SetParallelism(1);
+	}
+
+	void testResultCache() {
+		SetResultCacheDirectory("testResultCache");
+		vector<int> betti;
+		matrix ric;
+		{
+			AbstractLieGroup<> G("0,0,12,13");
+			betti=G.BettiNumbers();
+			TS_ASSERT_EQUALS(G.BettiNumbers(),betti);
+			LeviCivitaConnection<true> omega(&G,RiemannianStructure(&G,G.e()));
+			ric=omega.RicciAsMatrix();
+		}
+		//a new group has a new frame; cached results must be expressed in terms of it
+		AbstractLieGroup<> G("0,0,12,13");
+		TS_ASSERT_EQUALS(G.BettiNumbers(),betti);
+		Subspace<DifferentialForm> closed=G.ClosedForms(2);
+		TS_ASSERT_EQUALS(closed.Dimension(),betti[2]+G.ExactForms(2).Dimension());
+		for (int i=1;i<=closed.Dimension();++i)
+			TS_ASSERT_EQUALS(G.d(closed.e(i)),0);
+		LeviCivitaConnection<true> omega(&G,RiemannianStructure(&G,G.e()));
+		TS_ASSERT_EQUALS(omega.Torsion(),ExVector(G.Dimension()));
+		TS_ASSERT_EQUALS(omega.RicciAsMatrix(),ric);
+		SetResultCacheDirectory("");
+		std::filesystem::remove_all("testResultCache");
+	}
+
 	void testExpandBug() 
 	{
 		AbstractLieGroup<> G("0,0,12,13");
@@ -714,6 +755,56 @@ public:
 		TS_ASSERT_EQUALS(omega.Nabla<Spinor>(M.e(2),g.u(1)),-1/ex(4)*g.CliffordDot(M.e(2),g.u(1)));
 		TS_ASSERT_EQUALS(omega.Nabla<Spinor>(M.e(3),g.u(1)),-1/ex(4)*g.CliffordDot(M.e(3),g.u(1)));
 	}
+
+	static ex ArchiveAndRestore(ex e) {
+		archive ar;
+		ar.archive_ex(e,"e");
+		stringstream s;
+		s<<ar;
+		archive restored;
+		s>>restored;
+		return restored.unarchive_ex(lst{},"e");
+	}
+
+	void testArchive() {
+		S3 M;
+		ex form=3*M.e(1)*M.e(2)-M.e(3);
+		TS_ASSERT_EQUALS(ArchiveAndRestore(M.e(1)),M.e(1));
+		TS_ASSERT_EQUALS(ArchiveAndRestore(form),form);
+		LeviCivitaConnection<true> leviCivita(&M,RiemannianStructure(&M,M.e()));
+		ex ric=leviCivita.Ricci();
+		TS_ASSERT_EQUALS(ArchiveAndRestore(ric),ric);
+		auto g=PseudoRiemannianStructureByOrthonormalFrame::FromTimelikeIndices(&M,M.e(),{},CliffordConvention::BAUM_KATH);
+		ex psi=g.u(0)+2*g.u(1);
+		TS_ASSERT_EQUALS(ArchiveAndRestore(psi),psi);
+
+		WorkerPool pool([&M] (const ex& alpha) {return M.d(alpha);},lst{},2);
+		TS_ASSERT_EQUALS(pool.Workers(),2);
+		exvector forms{M.e(1),form,M.e(1)*M.e(2)*M.e(3)};
+		exvector dforms=pool.Map(forms);
+		for (int i=0;i<forms.size();++i)
+			TS_ASSERT_EQUALS(dforms[i],M.d(forms[i]));
+	}
+
+	void testSaveAndLoad() {
+		S3 M;
+		LeviCivitaConnection<true> leviCivita(&M,RiemannianStructure(&M,M.e()));
+		map<string,ex> saved;
+		for (int i=1;i<=3;++i) saved["de"+ToString(i)]=M.d(M.e(i));
+		saved["curvature"]=leviCivita.CurvatureForm();
+		const char* filename="testSaveAndLoad.gar";
+		SaveExpressions(filename,saved);
+		lst frame;
+		for (auto& x : M.e()) frame.append(x);
+		auto loaded=LoadExpressions(filename,frame);
+		TS_ASSERT_EQUALS(loaded.size(),saved.size());
+		for (auto& x : saved)
+			TS_ASSERT_EQUALS(loaded[x.first],x.second);
+		//without known objects, the frame is replaced by a new one
+		auto unbound=LoadExpressions(filename);
+		TS_ASSERT_DIFFERS(unbound["de1"],saved["de1"]);
+		remove(filename);
+	}
 };
 
 
@@ -128,6 +128,48 @@ public:
 		TS_ASSERT_THROWS(ParseDifferentialForm(M.e(),"."),ParseError);
 		TS_ASSERT_THROWS(ParseDifferentialForm(M.e(),"\\"),ParseError);
 	}
+	void testSalamonNotationParser() {
+		ConcreteManifold M(120);
+		symbol a("a");
+		SalamonNotationParser parser(M.e(),a);
+		TS_ASSERT_EQUALS(parser.ParseForm("{1,12,105}"),M.e(1)*M.e(12)*M.e(105));
+		TS_ASSERT_EQUALS(parser.ParseForm("{ 12 , 1 }"),-M.e(1)*M.e(12));
+		TS_ASSERT_EQUALS(parser.ParseForm("2*{100}+[a]*{3} 4"),2*M.e(100)+a*M.e(3)*M.e(4));
+		TS_ASSERT_EQUALS(parser.ParseForm("{1,1}"),0);
+		TS_ASSERT_EQUALS(parser.ParseForm("12+21"),0);
+		ExVector forms=parser.ParseForms("-1,(1+2)(3-[a^2]*1),{110}a");
+		TS_ASSERT_EQUALS(forms.size(),3);
+		TS_ASSERT_EQUALS(forms[0],-M.e(1));
+		TS_ASSERT_EQUALS(forms[1],M.e(1)*M.e(3)+M.e(2)*M.e(3)-a*a*M.e(2)*M.e(1));
+		TS_ASSERT_EQUALS(forms[2],M.e(110)*M.e(10));
+		TS_ASSERT_THROWS(parser.ParseForm("{121}"),ParseError);
+		TS_ASSERT_THROWS(parser.ParseForm("{}"),ParseError);
+		TS_ASSERT_THROWS(parser.ParseForm("{1,}"),ParseError);
+		TS_ASSERT_THROWS(parser.ParseForm("{4294967297}"),ParseError);
+		TS_ASSERT_THROWS(parser.ParseForm("{4294967297,1}"),ParseError);
+		TS_ASSERT_THROWS(SalamonNotationParser{}.ParseTerms("{4294967297}"),ParseError);
+		TS_ASSERT_THROWS(SalamonNotationParser{}.ParseTerms("{2147483648}"),ParseError);
+		TS_ASSERT_EQUALS(parser.ParseForm("4294967297*1+1/4294967297*2"),numeric("4294967297")*M.e(1)+M.e(2)/numeric("4294967297"));
+		TS_ASSERT_THROWS(parser.ParseForm("1,2"),ParseError);
+		TS_ASSERT_THROWS(parser.ParseForm("[b]*1"),std::invalid_argument);
+		TS_ASSERT_EQUALS(ParseDifferentialForm(M.e(),"{99}-[sqrt(2)]*{100}"),M.e(99)-sqrt(ex(2))*M.e(100));
+	}
+	void testSalamonNotationTerms() {
+		symbol a("a");
+		auto forms=SalamonNotationParser{a}.ParseTerms("0,21-3*12,[a]*{7,3}+{3,7}");
+		TS_ASSERT_EQUALS(forms.size(),3);
+		TS_ASSERT(forms[0].empty());
+		TS_ASSERT_EQUALS(forms[1].size(),1);
+		TS_ASSERT_EQUALS(forms[1][0].indices,(vector<int>{1,2}));
+		TS_ASSERT_EQUALS(forms[1][0].coefficient,-4);
+		TS_ASSERT_EQUALS(forms[2].size(),1);
+		TS_ASSERT_EQUALS(forms[2][0].indices,(vector<int>{3,7}));
+		TS_ASSERT_EQUALS(forms[2][0].coefficient,1-a);
+		ConcreteManifold M(7);
+		TS_ASSERT_EQUALS(SalamonNotationParser::ToForm(M.e(),forms[2]),(1-a)*M.e(3)*M.e(7));
+		ConcreteManifold N(6);
+		TS_ASSERT_THROWS(SalamonNotationParser::ToForm(N.e(),forms[2]),ParseError);
+	}
 	void testToStringUsing() {
 		symbol psi("psi");
 		stringstream s;
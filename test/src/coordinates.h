@@ -28,6 +28,7 @@
 #include "wedge/base/normalform.h"
 
 #include "wedge/connections/connection.h"
+#include "wedge/connections/numericcurvature.h"
 #include "wedge/liealgebras/liegroup.h"
 #include "wedge/liealgebras/liegroupextension.h"
 #include "wedge/liealgebras/liesubgroup.h"
@@ -159,6 +160,28 @@ public:
 		TS_ASSERT_EQUALS(X.LieDerivative(X.e(1),X.e(2)*X.e(4)),Hook(X.e(1),X.d(X.e(2)*X.e(4)))+X.d(Hook(X.e(1),X.e(2)*X.e(4))));
 	}
 
+	void testDerivativeCache() {
+		ManifoldWithCoordinates M(2);
+		ex f=Function(N.f);
+		auto before=M.GetFunctionDerivativeCacheStatistics();
+		ex Xf=M.LieDerivative(M.e(1),f);
+		auto after=M.GetFunctionDerivativeCacheStatistics();
+		TS_ASSERT_EQUALS(after.misses,before.misses+1);
+		TS_ASSERT_EQUALS(M.LieDerivative(M.e(1),f),Xf);
+		TS_ASSERT_EQUALS(M.GetFunctionDerivativeCacheStatistics().hits,after.hits+1);
+
+		M.SetFunctionDerivativeCacheCapacity(1);
+		TS_ASSERT_EQUALS(M.GetFunctionDerivativeCacheStatistics().entries,1);
+		ex Yf=M.LieDerivative(M.e(2),f);
+		TS_ASSERT_EQUALS(M.GetFunctionDerivativeCacheStatistics().entries,1);
+		TS_ASSERT(M.GetFunctionDerivativeCacheStatistics().evictions>after.evictions);
+		TS_ASSERT_EQUALS(M.LieDerivative(M.e(1),f),Xf);
+
+		M.SetFunctionDerivativeCacheCapacity(0);
+		TS_ASSERT_EQUALS(M.GetFunctionDerivativeCacheStatistics().entries,0);
+		TS_ASSERT_EQUALS(M.LieDerivative(M.e(1),Yf),M.LieDerivative(M.e(2),Xf));
+	}
+
 	void testCoordinates() {
 		ManifoldWithCoordinates M(3);
 		ex dx1=M.d(M.x(1)), dx2=M.d(M.x(2)), dx3=M.d(M.x(3));
@@ -200,6 +223,31 @@ public:
 			k.DeclareNabla<DifferentialForm>(S2.e(i),S2.e(j),S2.omega.Nabla<DifferentialForm>(S2.e(i),S2.e(j)));
 		TS_ASSERT_EQUALS(ex(R).normal(),ex(k.CurvatureForm()).normal());
 	}
+
+	void testNumericCurvature() {
+		TwoSphere S2;
+		NumericCurvature K(S2.omega,S2.x());
+		TS_ASSERT_EQUALS(K.Dimension(),2);
+		TS_ASSERT_EQUALS(K.Coordinates(),2);
+		vector<double> points{0.3,-0.5, 1,2, 0,0};
+		vector<double> s=K.ScalarCurvature(points);
+		vector<double> ric=K.RicciAsMatrix(points);
+		vector<double> R=K.CurvatureForm(points);
+		TS_ASSERT_EQUALS(s.size(),3);
+		TS_ASSERT_EQUALS(ric.size(),12);
+		TS_ASSERT_EQUALS(R.size(),48);
+		for (int p=0;p<3;++p) {
+			TS_ASSERT_DELTA(s[p],2,1e-10);
+			TS_ASSERT_DELTA(ric[4*p],1,1e-10);
+			TS_ASSERT_DELTA(ric[4*p+1],0,1e-10);
+			TS_ASSERT_DELTA(ric[4*p+3],1,1e-10);
+			TS_ASSERT_DELTA(R[16*p+1*4+0*2+1],1,1e-10);	//Omega_{01}(e_0,e_1)
+			TS_ASSERT_DELTA(R[16*p+1*4+1*2+0],-1,1e-10);
+			TS_ASSERT_DELTA(R[16*p+0],0,1e-10);
+		}
+		vector<complex<double>> z=K.ScalarCurvature(vector<complex<double>>{{0.3,0.1},{-0.5,0}});
+		TS_ASSERT_DELTA(z[0].real(),2,1e-10);
+	}
 };
 
 
@@ -150,6 +150,28 @@ public:
 		TS_ASSERT(coeffs.find(t)!=coeffs.end());
 	}
 
+	void testHashConsing() {
+		Lambda1<V> x,y,z;
+		ex a=x*y*z, b=-z*y*x, c=(x+z)*y*z;
+		TS_ASSERT_EQUALS(&ex_to<basic>(a),&ex_to<basic>(b));
+		TS_ASSERT_EQUALS(&ex_to<basic>(a),&ex_to<basic>(c));
+		LambdaTableStatistics before=GetLambdaTableStatistics<V>();
+		ex d=y*z*x;
+		LambdaTableStatistics after=GetLambdaTableStatistics<V>();
+		TS_ASSERT_EQUALS(&ex_to<basic>(a),&ex_to<basic>(d));
+		TS_ASSERT_EQUALS(after.created,before.created);
+		TS_ASSERT_EQUALS(after.reused,before.reused+1);
+		SetLambdaHashConsing(false);
+		ex e=z*x*y;
+		SetLambdaHashConsing(true);
+		TS_ASSERT_DIFFERS(&ex_to<basic>(a),&ex_to<basic>(e));
+		TS_ASSERT_EQUALS(a,e);
+		TS_ASSERT_EQUALS(GetLambdaTableStatistics<V>().created,after.created+1);
+		ex w=x*z;
+		PurgeLambdaTable<V>();
+		TS_ASSERT_EQUALS(&ex_to<basic>(w),&ex_to<basic>(z*x*-1));
+	}
+
 };
 
 #endif
@@ -31,6 +31,7 @@
 #include "wedge/liealgebras/su.h"
 #include "wedge/liealgebras/liegrouptostring.h"
 #include "wedge/liealgebras/derivations.h"
+#include "wedge/liealgebras/modularliealgebra.h"
 #include "wedge/polynomialalgebra/cocoapolyalg.h"
 #include "wedge/polynomialalgebra/polybasis.h"
 #include "wedge/representations/gl.h"
@@ -247,6 +248,33 @@ public:
 		TS_ASSERT_EQUALS(betti[5],1);
 	}
 
+	void testStructureConstantsTable() {
+		AbstractLieGroup<> G("23,31,12,0,0");
+		auto table=G.StructureConstantsTable();
+		TS_ASSERT(table!=nullptr);
+		TS_ASSERT_EQUALS(table->size(),3);
+		auto entry=table->find(internal::FrameMask{0b110});
+		TS_ASSERT(entry!=table->end());
+		TS_ASSERT_EQUALS(entry->second.size(),1);
+		TS_ASSERT_EQUALS(entry->second[0].first,0);
+		TS_ASSERT_EQUALS(entry->second[0].second,-1);
+		TS_ASSERT_EQUALS(G.StructureConstantsTable(),table);
+
+		exvector h{G.e(1)+2*G.e(3),G.e(2)};
+		vector<exvector> brackets;
+		TS_ASSERT(internal::BracketsFromStructureConstants(G,h,brackets));
+		TS_ASSERT_EQUALS(brackets[0][1],G.LieBracket(h[0],h[1]));
+
+		AbstractLieGroup<> K("0,0,0,12,13,23");
+		AbstractLieSubgroup<false> H(K,{K.e(1),K.e(2),K.e(4)});
+		TS_ASSERT_EQUALS(H.d(H.e(1)),0);
+		TS_ASSERT_EQUALS(H.d(H.e(2)),0);
+		TS_ASSERT_EQUALS(H.d(H.e(3)),H.e(1)*H.e(2));
+		LieSubgroup<false> H2(K,{K.e(1),K.e(2),K.e(4)});
+		TS_ASSERT_EQUALS(H2.d(K.e(1)),0);
+		TS_ASSERT_EQUALS(H2.d(K.e(4)),K.e(1)*K.e(2));
+	}
+
 
 	//test so.h
 	void testSO()
@@ -341,6 +369,11 @@ public:
 		TS_ASSERT(der.Contains(gl.A(1,2)-gl.A(2,1)));
 		TS_ASSERT(der.Contains(gl.A(3,2)-gl.A(2,3)));
 		TS_ASSERT(der.Contains(gl.A(1,3)-gl.A(3,1)));
+		AbstractLieGroup<> H("0,0,12,13,14");
+		GL gl5(5);
+		auto derH=derivations(H,gl5);
+		TS_ASSERT_EQUALS(derH.Dimension(),9);
+		TS_ASSERT(derH.Contains(gl5.A(5,5)+gl5.A(4,4)+gl5.A(3,3)+gl5.A(2,2)));
 	}
 
 	void test_lie_group_to_string() {
@@ -353,6 +386,76 @@ public:
 		AbstractLieGroup<true> G4("0,[a]*12,[sqrt(2)]*13",N.a);
 		TS_ASSERT_EQUALS(lie_group_to_string(G4),"0,[a]*12,[sqrt(2)]*13");
 	}
+
+	void testModularLieAlgebra() {
+		typedef ModularLieAlgebra::Element Element;
+		AbstractLieGroup<> H("0,0,12");
+		ModularLieAlgebra h(H,exmap{});
+		Element p=h.Prime();
+		TS_ASSERT_EQUALS(h.Bracket(1,2,3),p-1);
+		TS_ASSERT_EQUALS(h.Bracket(2,1,3),1);
+		TS_ASSERT(h.SatisfiesJacobi());
+		TS_ASSERT(h.IsUnimodular());
+		TS_ASSERT_EQUALS(h.BettiNumbers(),(vector<int>{1,2,2,1}));
+		auto ricci=h.RicciMatrix();
+		TS_ASSERT_EQUALS(ricci[0][0],ModularLieAlgebra::Reduce(numeric(-1,2),p));
+		TS_ASSERT_EQUALS(ricci[1][1],ModularLieAlgebra::Reduce(numeric(-1,2),p));
+		TS_ASSERT_EQUALS(ricci[2][2],ModularLieAlgebra::Reduce(numeric(1,2),p));
+		TS_ASSERT_EQUALS(ricci[0][1],0);
+		TS_ASSERT_EQUALS(h.ScalarCurvature(),ModularLieAlgebra::Reduce(numeric(-1,2),p));
+		ModularLieAlgebra h2(H,exmap{},p,exvector{H.e(1),H.e(2),2*H.e(3)});
+		TS_ASSERT_EQUALS(h2.Bracket(1,2,3),p-2);
+		TS_ASSERT_THROWS(ModularLieAlgebra(H,exmap{},p,exvector{H.e(1),H.e(2),0}),WedgeException<std::runtime_error>);
+
+		TS_ASSERT(!ModularLieAlgebra(LieGroupFamily("0,0,12,0,34"),exmap{}).SatisfiesJacobi());
+		TS_ASSERT(!ModularLieAlgebra(AbstractLieGroup<>("0,12"),exmap{}).IsUnimodular());
+		TS_ASSERT_EQUALS(ModularLieAlgebra::Rank({{1,2},{2,4}},7),1);
+		TS_ASSERT_EQUALS(ModularLieAlgebra::Rank({{1,2},{2,5}},7),2);
+		TS_ASSERT_EQUALS(ModularLieAlgebra::Rank({{1,2},{2,4+7}},7),1);
+	}
+
+	void testScreenParameters() {
+		auto jacobi=[] (const ModularLieAlgebra& g) {return ModularSignature{g.SatisfiesJacobi()};};
+		LieGroupFamily G("0,0,[a]*12",N.a);
+		auto samples=ScreenParameters(G,jacobi,5);
+		TS_ASSERT_EQUALS(samples.size(),5);
+		for (auto& sample : samples) {
+			TS_ASSERT_EQUALS(sample.signature,ModularSignature{1});
+			TS_ASSERT_EQUALS(sample.parameters.size(),1);
+		}
+		auto betti=[] (const ModularLieAlgebra& g) {return g.BettiNumbers();};
+		for (auto& sample : ScreenParameters(G,betti,3))
+			TS_ASSERT_EQUALS(sample.signature,(ModularSignature{1,2,2,1}));
+		LieGroupFamily F("0,0,12,0,[a]*34",N.a);
+		for (auto& sample : ScreenParameters(F,jacobi,5))
+			TS_ASSERT_EQUALS(sample.signature,ModularSignature{0});
+		LieGroupFamily D("0,0,[1/a]*12",N.a);
+		auto unimodular=[] (const ModularLieAlgebra& g) {return ModularSignature{g.IsUnimodular()};};
+		TS_ASSERT_EQUALS(ScreenParameters(D,unimodular,4).size(),4);
+	}
+
+	void testLoadLieGroups() {
+		stringstream s{"0,0,12\n# a comment\n\n  0,0,0,12,13\n0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,{1,16}\n"};
+		auto groups=LoadLieGroups(s);
+		TS_ASSERT_EQUALS(groups.size(),3);
+		TS_ASSERT_EQUALS(groups[0]->Dimension(),3);
+		TS_ASSERT_EQUALS(groups[1]->Dimension(),5);
+		TS_ASSERT_EQUALS(groups[1]->d(groups[1]->e(5)),groups[1]->e(1)*groups[1]->e(3));
+		TS_ASSERT_EQUALS(groups[2]->Dimension(),17);
+		TS_ASSERT_EQUALS(groups[2]->d(groups[2]->e(17)),groups[2]->e(1)*groups[2]->e(16));
+		AbstractLieGroup<> G("0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,{1,16}");
+		TS_ASSERT_EQUALS(G.d(G.e(17)),G.e(1)*G.e(16));
+
+		stringstream t{"0,0,12,13\n0,0,12\n0,0,0,12,13+24\n"};
+		vector<int> dimensions;
+		TS_ASSERT_EQUALS(ForEachLieGroup(t,[&dimensions] (const AbstractLieGroup<>& G) {dimensions.push_back(G.Dimension());}),3);
+		TS_ASSERT_EQUALS(dimensions,(vector<int>{4,3,5}));
+
+		stringstream u{"0,0,12\n0,0,14\n"};
+		TS_ASSERT_THROWS(LoadLieGroups(u),ParseError);
+		stringstream v{"0,0,12-\n"};
+		TS_ASSERT_THROWS(LoadLieGroups(v),ParseError);
+	}
 };
 
 
@@ -69,8 +69,13 @@ public:
 			Declare_d(e(2),e(1)*e(2));
 			Declare_d(e(3),0);
 			TS_ASSERT_THROWS(Check_ddZero(),WedgeException<runtime_error>);
+			TS_ASSERT_EQUALS(LieBracket(e(1),e(2)),-e(2));
 			Declare_d(e(2),e(1)*e(3));
 			Check_ddZero();
+			TS_ASSERT_EQUALS(dFrame()[1],e(1)*e(3));
+			TS_ASSERT_EQUALS(LieBracket(e(1),e(2)),0);
+			TS_ASSERT_EQUALS(LieBracket(e(1),e(3)),-e(2));
+			TS_ASSERT_EQUALS(LieBracket(e(2)+e(3),2*e(1)),2*e(2));
 			  
 			TS_ASSERT_EQUALS(d(e(1)+e(2)),e(2)*e(3)+e(1)*e(3));
 			TS_ASSERT_EQUALS(d(e(1)-e(2)),e(2)*e(3)-e(1)*e(3));
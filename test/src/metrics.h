@@ -25,6 +25,7 @@
 #include "test.h"
 #include "wedge/linearalgebra/bilinearform.h"
 #include "wedge/structures/pseudoriemannianstructure.h"
+#include "wedge/structures/riemannianstructure.h"
 
 using namespace Wedge;
 
@@ -138,6 +139,84 @@ public:
 		TS_ASSERT_EQUALS(g.ScalarProduct().OnVectors(M.e(4),M.e(4)),-1);
 	}
 
+	void testGramMinors() {
+		ConcreteManifold M(4);
+		symbol a("a"),b("b");
+		matrix m{{1,a,0,0},{a,2,0,b},{0,0,3,0},{0,b,0,1}};
+		auto g=ScalarProductDefinedByMatrix::OnCoframe(M.e(),m);
+		TS_ASSERT_EQUALS(g.OnForms(M.e(1)*M.e(2),M.e(1)*M.e(2)),2-a*a);
+		TS_ASSERT_EQUALS(g.OnForms(M.e(2)*M.e(1),M.e(1)*M.e(4)),-b);
+		TS_ASSERT_EQUALS(g.OnForms(M.e(3),M.e(1)*M.e(4)),0);
+		exvector forms{M.e(1)+a*M.e(4), M.e(2)*M.e(4)-b*M.e(3)*M.e(1), (a+b)*M.e(1)*M.e(2)*M.e(4)+M.e(3)*M.e(2)*M.e(4), M.e(4)*M.e(3)};
+		for (auto& v: forms)
+		for (auto& w: forms) {
+			TS_ASSERT_EQUALS(g.OnForms(v,w),g.BilinearForm::OnForms(v,w));
+			TS_ASSERT(NormalForm<DifferentialForm>(g.Interior(v,w)-g.BilinearForm::Interior(v,w)).is_zero());
+		}
+		auto h=ScalarProductByOrthogonalFrame::FromFormSquareNorms(M.e(),ExVector{1,a,b,2});
+		for (auto& v: forms)
+		for (auto& w: forms) {
+			TS_ASSERT_EQUALS(h.OnForms(v,w),h.BilinearForm::OnForms(v,w));
+			TS_ASSERT(NormalForm<DifferentialForm>(h.Interior(v,w)-h.BilinearForm::Interior(v,w)).is_zero());
+		}
+	}
+
+	void testLargeFrames() {
+		internal::FrameMask I=internal::FrameMask::Singleton(3), J=internal::FrameMask::Singleton(70);
+		TS_ASSERT_EQUALS((I|J).Size(),2);
+		TS_ASSERT((I|J)==(J|I));
+		TS_ASSERT_EQUALS((I|J).Hash(),(J|I).Hash());
+		TS_ASSERT_EQUALS((I|J).Lowest(),3);
+		TS_ASSERT_EQUALS((I|J).Highest(),70);
+		TS_ASSERT_EQUALS((I|J).CountFrom(4),1);
+		TS_ASSERT_EQUALS((I|J).CountFrom(71),0);
+		TS_ASSERT(I<J);
+		TS_ASSERT(J.IsSubsetOf(I|J));
+		TS_ASSERT(!J.IsSubsetOf(I));
+		TS_ASSERT_EQUALS(internal::FrameMask::FirstIndices(70).Size(),70);
+		TS_ASSERT(internal::FrameMask::FirstIndices(70).Contains(69));
+		TS_ASSERT(!internal::FrameMask::FirstIndices(70).Contains(70));
+
+		ConcreteManifold M(70);
+		symbol a("a");
+		ExVector norms(70,1);
+		norms(66)=a;
+		auto g=ScalarProductByOrthogonalFrame::FromFormSquareNorms(M.e(),norms);
+		exvector forms{M.e(1)*M.e(66), M.e(66)+a*M.e(3), M.e(2)*M.e(66)*M.e(70)-M.e(66)*M.e(1)*M.e(2)};
+		for (auto& v: forms)
+		for (auto& w: forms) {
+			TS_ASSERT_EQUALS(g.OnForms(v,w),g.BilinearForm::OnForms(v,w));
+			TS_ASSERT(NormalForm<DifferentialForm>(g.Interior(v,w)-g.BilinearForm::Interior(v,w)).is_zero());
+		}
+		RiemannianStructure h(&M,M.e());
+		TS_ASSERT_EQUALS(h.Hook(M.e(66),M.e(1)*M.e(66)),-M.e(1));
+		TS_ASSERT_EQUALS(h.Hook(M.e(3),M.e(1)*M.e(66)),0);
+	}
+
+	void testRiemannianHookTables() {
+		ConcreteManifold M(4);
+		RiemannianStructure g(&M,M.e());
+		TS_ASSERT_EQUALS(g.Hook(M.e(1),M.e(1)*M.e(2)),M.e(2));
+		TS_ASSERT_EQUALS(g.Hook(M.e(2),M.e(1)*M.e(2)),-M.e(1));
+		TS_ASSERT_EQUALS(g.Hook(M.e(1)*M.e(2),M.e(1)*M.e(2)),1);
+		TS_ASSERT_EQUALS(g.Hook(M.e(3),M.e(1)*M.e(2)),0);
+		TS_ASSERT_EQUALS(g.HodgeStar(M.e(1)*M.e(2)),M.e(3)*M.e(4));
+		TS_ASSERT_EQUALS(g.HodgeStar(M.e(2)*M.e(1)),-M.e(3)*M.e(4));
+		TS_ASSERT_THROWS(g.HodgeStar(M.e(1)+M.e(1)*M.e(2)),InhomogeneousExpression);
+
+		//changing the sign of e^1 changes the orientation, but not the metric; the frame is no longer made of simple forms
+		RiemannianStructure h(&M,ParseDifferentialForms(M.e(),"-1,2,3,4"));
+		symbol a("a"),b("b");
+		ex alpha=a*M.e(2)*M.e(1)+b*M.e(1)*M.e(3)+M.e(4)*M.e(2);
+		ex beta=(a+b)*M.e(1)*M.e(2)*M.e(3)+M.e(4)*M.e(3)*M.e(2)-M.e(1)*M.e(2)*M.e(4);
+		TS_ASSERT_EQUALS(g.HodgeStar(alpha),-h.HodgeStar(alpha));
+		TS_ASSERT_EQUALS(g.Hook(alpha,beta),h.Hook(alpha,beta));
+		TS_ASSERT_EQUALS(g.Hook(M.e(3),beta),h.Hook(M.e(3),beta));
+		TS_ASSERT_EQUALS(g.ScalarProduct<DifferentialForm>(alpha,alpha),h.ScalarProduct<DifferentialForm>(alpha,alpha));
+		TS_ASSERT_EQUALS(g.ScalarProduct<DifferentialForm>(alpha,alpha),(a*a+b*b+1).expand());
+		TS_ASSERT_EQUALS(g.ScalarProduct<DifferentialForm>(beta,M.e(1)*M.e(2)*M.e(4)),-1);
+	}
+
 
 
 	void testCliffordRiemannianOdd() {
@@ -309,6 +388,62 @@ public:
 		do_test_volume(M5);
 		do_test_volume(M7);
 	}
+
+	void testSpinorIndex() {
+		Spinor u=Spinor::from_epsilons({1,-1,-1});
+		TS_ASSERT_EQUALS(ex(u),ex(Spinor::from_index_and_dimension(6,7)));
+		TS_ASSERT_EQUALS(ex(u.reflect(1)),ex(Spinor::from_epsilons({-1,-1,-1})));
+		TS_ASSERT_EQUALS(ex(u.reflect(3)),ex(Spinor::from_epsilons({1,-1,1})));
+		TS_ASSERT_EQUALS(u.product_up_to(0),1);
+		TS_ASSERT_EQUALS(u.product_up_to(1),1);
+		TS_ASSERT_EQUALS(u.product_up_to(2),-1);
+		TS_ASSERT_EQUALS(u.product_up_to(3),1);
+		TS_ASSERT_THROWS_NOTHING(Spinor::from_index_and_dimension(1,2*Spinor::MaxLength));
+		TS_ASSERT_THROWS(Spinor::from_index_and_dimension(0,2*Spinor::MaxLength+2),OutOfRange);
+	}
+
+	void testCliffordByFrameVector() {
+		ConcreteManifold M(5);
+		symbol x("x");
+		for (auto convention : {CliffordConvention::BAUM_KATH, CliffordConvention::STANDARD}) {
+			auto g =PseudoRiemannianStructureByOrthonormalFrame::FromTimelikeIndices(&M,M.e(),{2},convention);
+			for (int j=1;j<=5;++j) 
+			for (int k=0;k<g.DimensionOfSpinorRepresentation();++k) {
+				ex psi=g.u(k)+x*g.u((k+1)%g.DimensionOfSpinorRepresentation());
+				TS_ASSERT_EQUALS(g.CliffordDotByFrameVector(j,psi).expand(),g.CliffordDot(M.e(j),psi).expand());
+				TS_ASSERT_EQUALS(g.CliffordDotByFrameVector(j,g.CliffordDotByFrameVector(j,g.u(k))),j==2? g.u(k) : -g.u(k));
+				for (int h=1;h<j;++h)
+					TS_ASSERT_EQUALS(g.CliffordDotByFrameVector(j,g.CliffordDotByFrameVector(h,g.u(k)))+g.CliffordDotByFrameVector(h,g.CliffordDotByFrameVector(j,g.u(k))),0);
+			}
+			TS_ASSERT_THROWS(g.CliffordDotByFrameVector(0,g.u(0)),OutOfRange);
+			TS_ASSERT_THROWS(g.CliffordDotByFrameVector(6,g.u(0)),OutOfRange);
+		}
+	}
+
+	void testCliffordDotAsMatrix() {
+		ConcreteManifold M(5);
+		symbol x("x");
+		auto g=PseudoRiemannianStructureByOrthogonalFrame(&M,M.e(),ExVector{1,-1,2,1,3},CliffordConvention::STANDARD);
+		ex alpha=M.e(1)*M.e(3)+x*M.e(2)*M.e(4)*M.e(5)-M.e(4);
+		matrix A=g.CliffordDotAsMatrix(alpha);
+		for (int h=0;h<g.DimensionOfSpinorRepresentation();++h) {
+			ex image;
+			for (int k=0;k<g.DimensionOfSpinorRepresentation();++k)
+				image+=A(k,h)*g.u(k);
+			TS_ASSERT_EQUALS((g.CliffordDotByForm(alpha,g.u(h))-image).expand(),0);
+			ex sequential=g.CliffordDot(M.e(1),g.CliffordDot(M.e(3)/2,g.u(h)))+x*g.CliffordDot(-M.e(2),g.CliffordDot(M.e(4),g.CliffordDot(M.e(5)/3,g.u(h))))-g.CliffordDot(M.e(4),g.u(h));
+			TS_ASSERT_EQUALS((sequential-image).expand(),0);
+		}
+		matrix e12=g.CliffordDotAsMatrix(M.e(1)*M.e(2));
+		TS_ASSERT(e12.sub(g.CliffordDotAsMatrix(M.e(1)).mul(g.CliffordDotAsMatrix(M.e(2)))).is_zero_matrix());
+
+		ExVector frame{M.e(1),M.e(1)+M.e(2),M.e(3),M.e(4),M.e(5)};
+		RiemannianStructure h(&M,frame);
+		ex beta=frame(1)*frame(2);
+		matrix B=h.CliffordDotAsMatrix(beta);
+		for (int k=0;k<h.DimensionOfSpinorRepresentation();++k)
+			TS_ASSERT_EQUALS((B(k,0)-h.CliffordDotByForm(beta,h.u(0)).expand().coeff(h.u(k))).expand(),0);
+	}
 private:
 	//product by a sequence of vectors
 	ex clifford(exvector e, ex u, const PseudoRiemannianStructureByOrthonormalFrame& g) {
@@ -23,6 +23,7 @@
 #include "test.h"
 #include "wedge/polynomialalgebra/cocoapolyalg.h"
 #include "wedge/polynomialalgebra/polybasis.h"
+#include "wedge/polynomialalgebra/sparsepolynomial.h"
 #include "wedge/manifolds/coordinates.h"
 
 
@@ -217,6 +218,162 @@ public:
 		TS_ASSERT(!I.Intersected(J).IdealContains(x*x));
 	}
 
+	void testLargeCoefficients()
+	{
+		V x(N.x),y(N.y);
+		ex big=pow(ex(2),100)+1;
+		PolyBasisImpl I;
+		I.push_back(x-big*y);
+		I.push_back(y*y-1/big);
+		TS_ASSERT(I.IdealContains(x*x-big));
+		TS_ASSERT(!I.IdealContains(x*x-big+1));
+		TS_ASSERT_EQUALS(I.ReduceModuloIdeal(x*x),big);
+		I.Reduce();
+		TS_ASSERT(!I.IdealIsOne());
+		TS_ASSERT(I.IdealContains(x*x-big));
+		TS_ASSERT(I.IdealContains(x*x*y-big*y));
+	}
+
+	void testCachedIdeal()
+	{
+		V x(N.x),y(N.y),z(N.z);
+		PolyBasisImpl I;
+		I.push_back(x*y-z);
+		I.push_back(y*y-1);
+		TS_ASSERT(I.IdealContains(x-y*z));
+		TS_ASSERT(!I.IdealContains(x));
+		TS_ASSERT(!I.IdealIsOne());
+		TS_ASSERT(I.IdealContains(x*x-z*z));
+		TS_ASSERT_EQUALS(I.ReduceModuloIdeal(y*y*y),I.ReduceModuloIdeal(y));
+		I.TakeVariableToFront(z);
+		TS_ASSERT(I.IdealContains(x-y*z));
+		TS_ASSERT_EQUALS(I.ReduceModuloIdeal(y*y*x-z*y),I.ReduceModuloIdeal(x-y*z));
+		//a variable not in the ideal
+		V t(N.t);
+		TS_ASSERT(I.IdealContains(t*(x-y*z)));
+		TS_ASSERT(!I.IdealContains(t));
+		//modifying the basis must discard the cached ideal
+		I.push_back(z);
+		TS_ASSERT(I.IdealContains(x));
+		TS_ASSERT_EQUALS(I.ReduceModuloIdeal(x),0);
+		I.push_back(y);
+		TS_ASSERT(I.IdealIsOne());
+		I.clear();
+		TS_ASSERT(!I.IdealIsOne());
+		TS_ASSERT(!I.IdealContains(x));
+	}
+
+	void testBatch()
+	{
+		V x(N.x),y(N.y),z(N.z);
+		PolyBasisImpl I;
+		I.push_back(x*y-z);
+		I.push_back(y*y-1);
+		exvector polys{x-y*z, x, x*x-z*z, 0, y*y*y-y, z*z};
+		vector<bool> expected{true,false,true,true,true,false};
+		exvector reduced;
+		for (auto& p : polys) reduced.push_back(I.ReduceModuloIdeal(p));
+		for (int processes=1;processes<=2;++processes) {
+			SetParallelism(processes);
+			TS_ASSERT_EQUALS(I.IdealContains(polys.begin(),polys.end()),expected);
+			TS_ASSERT_EQUALS(I.RadicalContains(polys.begin(),polys.end()),expected);
+			TS_ASSERT_EQUALS(I.ReduceModuloIdeal(polys.begin(),polys.end()),reduced);
+			//a second batch of the same operation reuses the workers
+			TS_ASSERT_EQUALS(I.ReduceModuloIdeal(polys.begin(),polys.end()),reduced);
+		}
+		//the workers are discarded when the ideal changes
+		I.push_back(z*z);
+		vector<bool> radical=I.RadicalContains(polys.begin(),polys.end());
+		TS_ASSERT(radical[1]);
+		TS_ASSERT(radical[5]);
+		vector<bool> contained=I.IdealContains(polys.begin(),polys.end());
+		TS_ASSERT(!contained[1]);
+		TS_ASSERT(contained[5]);
+		SetParallelism(1);
+	}
+
+	void testModularCheck()
+	{
+		V x(N.x),y(N.y),z(N.z);
+		TS_ASSERT_EQUALS(CocoaPolyAlgorithms::ModularPrimes(),0);
+		TS_ASSERT_THROWS(CocoaPolyAlgorithms::SetModularPrimes(-1),OutOfRange);
+		TS_ASSERT_THROWS(CocoaPolyAlgorithms::SetModularPrimes(CocoaPolyAlgorithms::MaxModularPrimes()+1),OutOfRange);
+		CocoaPolyAlgorithms::SetModularPrimes(3);
+		PolyBasisImpl I;
+		I.push_back(x*x+y*y-1);
+		I.push_back(x*y-z/3);
+		TS_ASSERT(!I.IdealIsOne());
+		TS_ASSERT(I.RadicalContains(x*x*x*y+x*y*y*y-z/3));
+		TS_ASSERT(!I.RadicalContains(x));
+		I.push_back(x*z);
+		I.push_back(y*z-1);
+		TS_ASSERT(I.IdealIsOne());
+		//the first prime divides a coefficient, and must be skipped
+		PolyBasisImpl J;
+		J.push_back(1073741789*x-1);
+		J.push_back(x);
+		TS_ASSERT(J.IdealIsOne());
+		TS_ASSERT(J.RadicalContains(y));
+		CocoaPolyAlgorithms::SetModularPrimes(0);
+	}
+
+	void testSparsePolynomial()
+	{
+		V x(N.x),y(N.y),z(N.z);
+		PolynomialRing R(exvector{x,y});
+		ex p=pow(x+y,2)-3*x/2, q=x*y-1, big=pow(ex(2),100)+1;
+		TS_ASSERT(R.FromEx(0).IsZero());
+		TS_ASSERT_EQUALS(R.ToEx(R.FromEx(p)),p.expand());
+		TS_ASSERT_EQUALS(R.FromEx(p).NumTerms(),4);
+		TS_ASSERT_EQUALS(R.ToEx(R.FromEx(big*q)),(big*q).expand());
+		TS_ASSERT_EQUALS(R.ToEx(R.FromEx(p)*R.FromEx(q)),(p*q).expand());
+		TS_ASSERT_EQUALS(R.ToEx(R.FromEx(p)-R.FromEx(q)),(p-q).expand());
+		TS_ASSERT_EQUALS(R.ToEx(-R.FromEx(p)+R.FromEx(p)),0);
+		TS_ASSERT_EQUALS((R.FromEx(p)*R.FromEx(q)).ExactQuotient(R.FromEx(q)),R.FromEx(p));
+		TS_ASSERT_EQUALS(R.FromEx(pow(x,5)*y).ExactQuotient(R.FromEx(x*x)),R.FromEx(pow(x,3)*y));
+		TS_ASSERT_THROWS(R.FromEx(p).ExactQuotient(R.FromEx(q)),WedgeException<std::runtime_error>);
+		TS_ASSERT_THROWS(R.FromEx(p).ExactQuotient(SparsePolynomial()),WedgeException<std::runtime_error>);
+		TS_ASSERT_THROWS(R.FromEx(x*z),InvalidArgument);
+		TS_ASSERT_THROWS(R.FromEx(sqrt(ex(2))*x),InvalidArgument);
+		TS_ASSERT_THROWS(R.FromEx(pow(x,128)),OutOfRange);
+		TS_ASSERT_THROWS(R.FromEx(pow(x,100))*R.FromEx(pow(x,100)),WedgeException<std::runtime_error>);
+		TS_ASSERT_THROWS(R.FromEx(pow(x,100))*R.FromEx(pow(x,100)),ExponentOverflow);
+	}
+
+	void testSparsePolyLinAlg()
+	{
+		V a(N.a),b(N.b);
+		exvector rows[]={{a,b,1},{a*a,a*b,a},{1,b,a},{a+1,2*b,a+1}};
+		SparsePolyLinAlgAlgorithms::IndependenceMatrix m(4,3);
+		GinacLinAlgAlgorithms::IndependenceMatrix m2(4,3);
+		for (int i=0;i<4;++i)
+			for (int j=0;j<3;++j)
+				m.M(i,j)=m2.M(i,j)=rows[i][j];
+		m.ChooseLinearlyIndependentRows();
+		m2.ChooseLinearlyIndependentRows();
+		TS_ASSERT_EQUALS(list<int>(m.IndependentRowsBegin(),m.IndependentRowsEnd()),(list<int>{0,2}));
+		TS_ASSERT(equal(m.IndependentRowsBegin(),m.IndependentRowsEnd(),m2.IndependentRowsBegin(),m2.IndependentRowsEnd()));
+		//entries which are not polynomials with rational coefficients
+		SparsePolyLinAlgAlgorithms::IndependenceMatrix m3(2,2);
+		m3.M(0,0)=sqrt(ex(2)); m3.M(0,1)=a;
+		m3.M(1,0)=2; m3.M(1,1)=sqrt(ex(2))*a;
+		m3.ChooseLinearlyIndependentRows();
+		TS_ASSERT_EQUALS(list<int>(m3.IndependentRowsBegin(),m3.IndependentRowsEnd()),(list<int>{0}));
+		//exponents overflowing the packed representation during the elimination
+		SparsePolyLinAlgAlgorithms::IndependenceMatrix m4(3,2);
+		m4.M(0,0)=pow(a,100); m4.M(0,1)=1;
+		m4.M(1,0)=1; m4.M(1,1)=pow(a,100);
+		m4.M(2,0)=a; m4.M(2,1)=b;
+		m4.ChooseLinearlyIndependentRows();
+		TS_ASSERT_EQUALS(list<int>(m4.IndependentRowsBegin(),m4.IndependentRowsEnd()),(list<int>{0,1}));
+		//exponents too large for the packed representation
+		SparsePolyLinAlgAlgorithms::IndependenceMatrix m5(2,2);
+		m5.M(0,0)=pow(a,128); m5.M(0,1)=a;
+		m5.M(1,0)=pow(a,129); m5.M(1,1)=a*a;
+		m5.ChooseLinearlyIndependentRows();
+		TS_ASSERT_EQUALS(list<int>(m5.IndependentRowsBegin(),m5.IndependentRowsEnd()),(list<int>{0}));
+	}
+
 	void testGroebner_R_multipleroots()
 	{
 		V x(N.x),y(N.y),z(N.z),t(N.t),s(N.s);
@@ -381,6 +538,26 @@ public:
 		TS_ASSERT((x-t).subs(subs).is_zero());
 		TS_ASSERT(basis.IdealContains((x-z*y*y).subs(subs)));
 	}
+
+	void testEliminateChain() 
+	{
+		U x(N.x),y(N.y),z(N.z),t(N.t);
+		exvector eqns{x-y*z, y-2*t, x*x-t*t*t, z*z*(z-t)};
+		PolyBasisImplementation<U,DefaultPolyAlgorithms> basis(eqns.begin(),eqns.end());
+		lst subs=basis.Eliminate();
+		TS_ASSERT(subs.nops()>=2);
+		for (auto& sub : subs) {
+			for (auto& p : basis) TS_ASSERT(!p.has(sub.lhs()));
+			for (auto& other : subs) TS_ASSERT(!other.rhs().has(sub.lhs()));
+		}
+		for (auto& p : eqns) TS_ASSERT(basis.IdealContains(p.subs(subs)));
+
+		PolyBasisImplementation<U,DefaultPolyAlgorithms> inconsistent;
+		inconsistent.push_back(x-y);
+		inconsistent.push_back(x-y-1);
+		inconsistent.Eliminate();
+		TS_ASSERT(inconsistent.IdealIsOne());
+	}
 };
 
 class ParseCocoaPolyTesTSuite : public  CxxTest::TestSuite {
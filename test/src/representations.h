@@ -189,6 +189,45 @@ public:
 	}	
 
 
+	void testActionMatrices() {
+		ConcreteManifold M(4);
+		GL gl(4);
+		GLRepresentation<VectorField> V(&gl, M.e());
+		ex A=gl.A(1,2)+2*gl.A(3,1)-gl.A(4,4);
+		const SparseEndomorphism& a=V.ActionMatrix(A);
+		TS_ASSERT_EQUALS(&V.ActionMatrix(A),&a);
+		for (int j=0;j<4;++j) {
+			ex image;
+			for (auto& entry: a[j]) image+=entry.second*M.e(entry.first+1);
+			TS_ASSERT_EQUALS((image-V.Action<VectorField>(A,M.e(j+1))).expand(),0);
+		}
+
+		auto monomials=SparseEndomorphism::Monomials(4,2);
+		TS_ASSERT_EQUALS(monomials.size(),6);
+		auto form=[&M,&monomials] (int i) {
+			ex result=1;
+			for (int k=0;k<4;++k)
+				if (monomials[i]&(1<<k)) result*=M.e(k+1);
+			return result;
+		};
+		SparseEndomorphism a2=a.OnLambda(2);
+		for (int j=0;j<6;++j) {
+			ex image;
+			for (auto& entry: a2[j]) image+=entry.second*form(entry.first);
+			TS_ASSERT_EQUALS((image-V.Action<DifferentialForm>(A,form(j))).expand(),0);
+		}
+
+		SparseEndomorphism a11=SparseEndomorphism::OnTensorProduct(a,a);
+		for (int i=0;i<4;++i)
+		for (int j=0;j<4;++j) {
+			ex image;
+			for (auto& entry: a11[i*4+j]) 
+				image+=entry.second*TensorProduct<VectorField,VectorField>(M.e(entry.first/4+1),M.e(entry.first%4+1));
+			ex v=TensorProduct<VectorField,VectorField>(M.e(i+1),M.e(j+1));
+			TS_ASSERT_EQUALS((image-V.Action<Tensor<VectorField,VectorField> >(A,v)).expand(),0);
+		}
+	}
+
 	//test stabilizer.h
 	void testStabilizer()
 	{
@@ -24,6 +24,8 @@
 #include "logging.h"
 #include "wedgebase.h"
 #include "wedgealgebraic.h"
+#include "zerotest.h"
+#include "simplificationcache.h"
 #include <ginac/power.h>
 /** @ingroup Base 
  * */
@@ -387,7 +389,8 @@ template<typename T> ex NormalForm(ex e)
 	exmap inverse; 	//collect similar coefficients
 	for (exmap::const_iterator i=v.coeffs.begin();i!=v.coeffs.end();++i)
 	{
-		ex normal=i->second.normal(); 
+		if (RandomizedZeroTesting() && ProbablyZero(i->second,RandomizedZeroTesting())) continue;	//skip the expensive normal() on vanishing coefficients
+		ex normal=CachedNormal(i->second); 
 		if (inverse.find(-normal)!=inverse.end()) 
 			inverse[-normal]-=i->first;
 		else
@@ -94,7 +94,8 @@ LambdaVectorNormalForm::LambdaVectorNormalForm(ex linear_combination) {
 ex VectorNormalForm::CollectCoefficients() const {
 	exmap inverse;
 	for (const auto& pair : coefficients) {
-		ex coeff=pair.second.normal(); 
+		if (RandomizedZeroTesting() && ProbablyZero(pair.second,RandomizedZeroTesting())) continue;
+		ex coeff=CachedNormal(pair.second); 
 		if (inverse.find(-coeff)!=inverse.end()) 
 			inverse[-coeff]-=pair.first;
 		else
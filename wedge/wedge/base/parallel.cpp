@@ -0,0 +1,283 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "wedgebase.h"
+#include "parallel.h"
+#include "logging.h"
+
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstdint>
+#include <numeric>
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+static int parallelism=1;
+
+void SetParallelism(int processes)
+{
+	if (processes<1) throw OutOfRange(__FILE__,__LINE__,processes);
+	parallelism=processes;
+}
+
+int Parallelism()
+{
+	return parallelism;
+}
+
+static void CollectSymbols(const ex& e, exset& found, lst& symbols)
+{
+	if (is_a<symbol>(e)) {
+		if (found.insert(e).second) symbols.append(e);
+	}
+	else for (const_iterator i=e.begin();i!=e.end();++i)
+		CollectSymbols(*i,found,symbols);
+}
+
+void CollectSymbols(const ex& e, lst& symbols)
+{
+	exset found(symbols.begin(),symbols.end());
+	CollectSymbols(e,found,symbols);
+}
+
+namespace internal {
+
+//header of a message sent to a worker; a negative index asks the worker to terminate
+struct TaskHeader {
+	int32_t index;		//index of the argument
+	uint64_t size;		//size of the archive following the header
+};
+
+//header of a message sent by a worker
+struct ResultHeader {
+	int32_t index;		//index of the argument
+	int32_t failed;		//nonzero if the evaluation threw an exception
+	uint64_t size;		//size of the archive following the header
+};
+
+static bool WriteAll(int fd, const char* data, size_t size)
+{
+	while (size>0) {
+		ssize_t written=send(fd,data,size,MSG_NOSIGNAL);
+		if (written<0) {
+			if (errno==EINTR) continue;
+			return false;
+		}
+		data+=written; size-=written;
+	}
+	return true;
+}
+
+static bool ReadAll(int fd, char* data, size_t size)
+{
+	while (size>0) {
+		ssize_t bytes=read(fd,data,size);
+		if (bytes<0 && errno==EINTR) continue;
+		if (bytes<=0) return false;
+		data+=bytes; size-=bytes;
+	}
+	return true;
+}
+
+template<typename Header> bool Send(int fd, const Header& header, const string& data)
+{
+	return WriteAll(fd,reinterpret_cast<const char*>(&header),sizeof(header)) && WriteAll(fd,data.data(),data.size());
+}
+
+static string ToArchive(const ex& e)
+{
+	archive ar;
+	ar.archive_ex(e,"ex");
+	ostringstream s;
+	s<<ar;
+	return s.str();
+}
+
+static ex FromArchive(const string& data, const lst& symbols)
+{
+	istringstream s(data);
+	archive ar;
+	s>>ar;
+	return ar.unarchive_ex(symbols,"ex");
+}
+
+//estimated cost of applying a task to an expression: the number of terms
+static int EstimatedCost(const ex& e)
+{
+	if (is_a<add>(e)) return e.nops();
+	else if (is_a<lst>(e) || is_a<matrix>(e)) {
+		int cost=0;
+		for (const_iterator i=e.begin();i!=e.end();++i) cost+=EstimatedCost(*i);
+		return cost;
+	}
+	else return 1;
+}
+
+}
+
+WorkerPool::WorkerPool(const Task& task, const lst& symbols, int processes) : task(task), symbols(symbols)
+{
+	if (processes<=1) return;
+	cout.flush(); cerr.flush(); internal::log.flush();
+	for (int k=0;k<processes;++k) {
+		int fd[2];
+		if (socketpair(AF_UNIX,SOCK_STREAM,0,fd)<0) break;
+		pid_t pid=fork();
+		if (pid<0) {
+			close(fd[0]); close(fd[1]);
+			break;
+		}
+		else if (pid==0) {
+			close(fd[0]);
+			for (auto& worker : workers) close(worker.fd);
+			parallelism=1;
+			RunWorker(fd[1]);
+			close(fd[1]);
+			_exit(0);
+		}
+		close(fd[1]);
+		workers.push_back(Worker{pid,fd[0]});
+	}
+	LOG_DEBUG(workers.size());
+}
+
+WorkerPool::~WorkerPool()
+{
+	for (auto& worker : workers) Terminate(worker);
+}
+
+void WorkerPool::Terminate(Worker& worker)
+{
+	if (worker.fd<0) return;
+	internal::Send(worker.fd,internal::TaskHeader{-1,0},string());
+	close(worker.fd);
+	waitpid(worker.pid,nullptr,0);
+	worker.fd=-1;
+	worker.task=-1;
+}
+
+//body of a worker process: apply the task to each argument received, until asked to terminate
+void WorkerPool::RunWorker(int fd)
+{
+	internal::TaskHeader header;
+	while (internal::ReadAll(fd,reinterpret_cast<char*>(&header),sizeof(header)) && header.index>=0) {
+		string data(header.size,'\0');
+		if (!internal::ReadAll(fd,&data[0],header.size)) break;
+		internal::ResultHeader result{header.index,0,0};
+		try {
+			data=internal::ToArchive(task(internal::FromArchive(data,symbols)));
+		}
+		catch (...) {
+			result.failed=1;
+			data.clear();
+		}
+		result.size=data.size();
+		if (!internal::Send(fd,result,data)) break;
+	}
+}
+
+exvector WorkerPool::Map(const exvector& arguments)
+{
+	const int n=arguments.size();
+	exvector result(n);
+	vector<bool> computed(n,false);
+	if (!workers.empty()) {
+		vector<int> costs;
+		for (auto& x: arguments) costs.push_back(internal::EstimatedCost(x));
+		vector<int> queue(n);
+		iota(queue.begin(),queue.end(),0);
+		stable_sort(queue.begin(),queue.end(),[&costs] (int i, int j) {return costs[i]>costs[j];});
+		lst all_symbols=symbols;
+		for (auto& x: arguments) CollectSymbols(x,all_symbols);
+
+		auto next=queue.begin();
+		bool archivable=true;	//set to false when a result cannot be unarchived; the remaining tasks are then computed serially rather than twice
+		auto dispatch=[this,&next,&queue,&arguments,&archivable] (Worker& worker) {
+			if (next==queue.end() || !archivable) return;
+			int i=*next++;
+			string data=internal::ToArchive(arguments[i]);
+			if (internal::Send(worker.fd,internal::TaskHeader{i,data.size()},data)) worker.task=i;
+			else Terminate(worker);
+		};
+		for (auto& worker : workers) dispatch(worker);
+		char chunk[65536];
+		while (true) {
+			vector<pollfd> polled;
+			vector<Worker*> busy;
+			for (auto& worker : workers) 
+				if (worker.task>=0) {
+					polled.push_back(pollfd{worker.fd,POLLIN,0});
+					busy.push_back(&worker);
+				}
+			if (polled.empty()) break;
+			if (poll(polled.data(),polled.size(),-1)<0) {
+				if (errno==EINTR) continue;
+				throw WedgeException<std::runtime_error>("poll failed while waiting for worker processes",__FILE__,__LINE__);
+			}
+			for (int k=0;k<polled.size();++k) {
+				if (polled[k].revents==0) continue;
+				Worker& worker=*busy[k];
+				ssize_t bytes=read(worker.fd,chunk,sizeof(chunk));
+				if (bytes<0 && errno==EINTR) continue;
+				else if (bytes<=0) {		//the worker died; its task will be computed serially
+					Terminate(worker);
+					continue;
+				}
+				worker.received.append(chunk,bytes);
+				internal::ResultHeader header;
+				if (worker.received.size()<sizeof(header)) continue;
+				worker.received.copy(reinterpret_cast<char*>(&header),sizeof(header));
+				if (worker.received.size()<sizeof(header)+header.size) continue;
+				if (!header.failed)
+					try {
+						result[header.index]=internal::FromArchive(worker.received.substr(sizeof(header),header.size),all_symbols);
+						computed[header.index]=true;
+					}
+					catch (const std::exception& e) {
+						LOG_INFO(e.what());
+						archivable=false;
+					}
+				worker.received.clear();
+				worker.task=-1;
+				dispatch(worker);
+			}
+		}
+		workers.erase(remove_if(workers.begin(),workers.end(),[] (const Worker& worker) {return worker.fd<0;}),workers.end());
+	}
+	//compute serially whatever the workers could not provide
+	for (int i=0;i<n;++i)
+		if (!computed[i]) result[i]=task(arguments[i]);
+	return result;
+}
+
+exvector ParallelMap(int n, const std::function<ex(int)>& f, const lst& symbols)
+{
+	WorkerPool pool([&f] (const ex& i) {return f(ex_to<numeric>(i).to_int());},symbols,min(parallelism,n));
+	exvector arguments;
+	arguments.reserve(n);
+	for (int i=0;i<n;++i) arguments.push_back(i);
+	return pool.Map(arguments);
+}
+
+}
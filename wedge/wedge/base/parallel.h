@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "wedge/base/wedgebase.h"
+#include <functional>
+#include <sys/types.h>
+
+/** @ingroup Base */ 
+
+/** @{ 
+ * @file parallel.h
+ * @brief Parallel evaluation of independent computations
+ *
+ * GiNaC expressions are reference counted without synchronization, so they cannot be shared between threads.
+ * Parallelism is obtained instead by forking worker processes, which inherit a copy of all the objects
+ * existing at the time of the fork (e.g. a manifold and its table of differentials); arguments and results are exchanged 
+ * with the workers through pipes, in %GiNaC's archive format.
+ *
+ * By default computations are serial; call SetParallelism to allow more than one process.
+ */
+
+namespace Wedge {
+
+using namespace GiNaC;
+using namespace std;
+
+/** @brief Set the maximum number of processes used by parallel computations
+ * @param processes The number of processes; a value of 1 (the default) means that all computations are performed serially in the calling process
+ */
+void SetParallelism(int processes);
+
+/** @brief Return the maximum number of processes used by parallel computations
+ */
+int Parallelism();
+
+/** @brief Collect the symbols appearing in an expression
+ * @param e An expression
+ * @param symbols A list to which the symbols are appended
+ *
+ * Useful to construct the argument of ParallelMap
+ */
+void CollectSymbols(const ex& e, lst& symbols);
+
+/** @brief A pool of worker processes applying a fixed function to expressions
+ *
+ * The workers are forked by the constructor, so they see the state of the program at that time; objects created afterwards 
+ * can only reach the workers as part of the arguments to Map. Tasks are dispatched one at a time to idle workers, 
+ * in decreasing order of estimated cost (the number of terms of the argument), so that long tasks do not end up queued behind short ones.
+ *
+ * Example: 
+ * @code
+ * WorkerPool pool([&M] (ex alpha) {return M.d(alpha);});
+ * exvector dalpha=pool.Map(forms);
+ * @endcode 
+ */
+class WorkerPool {
+public:
+	typedef std::function<ex(const ex&)> Task;
+/** @brief Fork the worker processes
+ * @param task The function to be applied to the arguments. It should not have side effects, since it is evaluated in a different process
+ * @param symbols The %GiNaC symbols that may appear in arguments and results; symbols not in this list are replaced with new symbols having the same name (objects of %Wedge classes keep their identity)
+ * @param processes The maximum number of workers
+ */
+	WorkerPool(const Task& task, const lst& symbols=lst{}, int processes=Parallelism());
+	WorkerPool(const WorkerPool&)=delete;
+	WorkerPool& operator=(const WorkerPool&)=delete;
+	~WorkerPool();	///< Terminate the worker processes
+
+/** @brief Apply the task to a sequence of expressions
+ * @param arguments A vector of expressions
+ * @return The vector of results, in the same order as the arguments
+ *
+ * If a worker fails, or if an argument or a result cannot be archived and reconstructed, the corresponding value is computed in the calling process;
+ * thus, exceptions thrown by the task propagate normally. Once a result cannot be reconstructed, no further arguments are sent to the workers, 
+ * so that the remaining values are computed once, in the calling process.
+ */
+	exvector Map(const exvector& arguments);
+
+/** @brief Return the number of worker processes alive; zero means that the task is evaluated serially
+ */
+	int Workers() const {return workers.size();}
+private:
+	struct Worker {
+		pid_t pid;
+		int fd;			//socket connected to the worker
+		int task=-1;		//index of the argument being processed, or -1 if idle
+		string received;	//partial output received from the worker
+	};
+	Task task;
+	lst symbols;
+	vector<Worker> workers;
+	void RunWorker(int fd);
+	void Terminate(Worker& worker);
+};
+
+/** @brief Evaluate a function on the integers 0,...,n-1, in parallel if possible
+ * @param n The number of evaluations
+ * @param f A function without side effects, to be evaluated on each integer in [0,n)
+ * @param symbols The %GiNaC symbols that may appear in the result; symbols not in this list are replaced with new symbols having the same name (objects of %Wedge classes keep their identity)
+ * @return The vector with elements f(0),...,f(n-1)
+ *
+ * The evaluations are distributed among at most Parallelism() worker processes, forked for the occasion (@sa WorkerPool). If a worker fails, or if its result
+ * contains objects that cannot be reconstructed from an archive, the corresponding value is recomputed in the calling process;
+ * thus, exceptions thrown by f propagate normally.
+ */
+exvector ParallelMap(int n, const std::function<ex(int)>& f, const lst& symbols=lst{});
+
+} /** @} */
+#endif
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "wedgebase.h"
+#include "persistence.h"
+#include "wedgealgebraic.h"
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+void SaveExpressions(const string& filename, const map<string,ex>& expressions)
+{
+	archive ar;
+	for (auto& named: expressions)
+		ar.archive_ex(named.second,named.first.c_str());
+	ofstream file(filename,ios::binary);
+	file<<ar;
+	if (!file) throw WedgeException<std::runtime_error>("Cannot write to file "+filename,__FILE__,__LINE__);
+}
+
+map<string,ex> LoadExpressions(const string& filename, const lst& known)
+{
+	ifstream file(filename,ios::binary);
+	if (!file) throw WedgeException<std::runtime_error>("Cannot read from file "+filename,__FILE__,__LINE__);
+	archive ar;
+	file>>ar;
+	map<string,ex> expressions;
+	internal::IdRemapping remapping;
+	for (unsigned i=0;i<ar.num_expressions();++i) {
+		string name;
+		ex e=ar.unarchive_ex(known,name,i);
+		expressions[name]=e;
+	}
+	return expressions;
+}
+
+}
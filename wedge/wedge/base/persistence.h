@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include "wedge/base/wedgebase.h"
+#include <map>
+
+/** @ingroup Base */ 
+
+/** @{ 
+ * @file persistence.h
+ * @brief Saving expressions to disk and loading them back
+ *
+ * Expressions are stored in %GiNaC's archive format. Objects of %Wedge classes carry an identity (e.g. the ID of a VectorField, or the serial 
+ * number of a Function), which is meaningless in a different run of the program; when loading, objects are therefore identified with the known objects 
+ * of the same type and name passed by the caller, and all other objects are given a new identity, consistently across the file.
+ */
+
+namespace Wedge {
+
+using namespace GiNaC;
+using namespace std;
+
+/** @brief Save a collection of named expressions to a file
+ * @param filename The name of the file to write
+ * @param expressions A map associating a name to each expression
+ *
+ * Example:
+ * @code
+ * map<string,ex> expressions;
+ * for (int i=1;i<=M.Dimension();++i) expressions["de"+ToString(i)]=M.d(M.e(i));
+ * expressions["curvature"]=omega.CurvatureForm();
+ * SaveExpressions("results.gar",expressions);
+ * @endcode
+ */
+void SaveExpressions(const string& filename, const map<string,ex>& expressions);
+
+/** @brief Load expressions saved by SaveExpressions
+ * @param filename The name of the file to read
+ * @param known A list of objects, e.g. the elements of a frame and the parameters; archived objects with the same type and name are identified with them
+ * @return A map associating each name to the corresponding expression
+ */
+map<string,ex> LoadExpressions(const string& filename, const lst& known=lst{});
+
+} /** @} */
+#endif
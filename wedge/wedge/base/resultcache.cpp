@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "wedgebase.h"
+#include "resultcache.h"
+#include "wedgealgebraic.h"
+#include "logging.h"
+#include "utilities.h"
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+namespace internal {
+
+static const char cache_magic[8]={'W','E','D','G','E','C','0','1'};
+
+//layout of a cache file: magic, key size, payload size, key, payload
+struct CacheFileHeader {
+	char magic[8];
+	uint64_t key_size;
+	uint64_t payload_size;
+};
+
+string& CacheDirectory() {
+	static string directory;
+	return directory;
+}
+
+//64-bit FNV-1a hash of the key; collisions are detected by comparing the stored key
+string CacheFileName(const string& key)
+{
+	uint64_t hash=14695981039346656037ull;
+	for (unsigned char c: key) {
+		hash^=c;
+		hash*=1099511628211ull;
+	}
+	char name[17];
+	snprintf(name,sizeof(name),"%016llx",static_cast<unsigned long long>(hash));
+	return CacheDirectory()+"/"+name+".wc";
+}
+
+bool WriteAll(int fd, const char* data, size_t size)
+{
+	while (size>0) {
+		ssize_t written=write(fd,data,size);
+		if (written<0) {
+			if (errno==EINTR) continue;
+			return false;
+		}
+		data+=written;
+		size-=written;
+	}
+	return true;
+}
+
+}
+
+void SetResultCacheDirectory(const string& directory)
+{
+	if (!directory.empty() && mkdir(directory.c_str(),0777)!=0 && errno!=EEXIST)
+		throw WedgeException<std::runtime_error>("Cannot create directory "+directory,__FILE__,__LINE__);
+	internal::CacheDirectory()=directory;
+}
+
+const string& ResultCacheDirectory()
+{
+	return internal::CacheDirectory();
+}
+
+bool LookupCachedResult(const string& key, ex& result, const lst& known)
+{
+	if (ResultCacheDirectory().empty()) return false;
+	string filename=internal::CacheFileName(key);
+	int fd=open(filename.c_str(),O_RDONLY);
+	if (fd<0) return false;
+	struct stat st;
+	void* mapped=MAP_FAILED;
+	if (fstat(fd,&st)==0 && st.st_size>=static_cast<off_t>(sizeof(internal::CacheFileHeader)))
+		mapped=mmap(nullptr,st.st_size,PROT_READ,MAP_SHARED,fd,0);
+	close(fd);
+	if (mapped==MAP_FAILED) return false;
+	const char* data=static_cast<const char*>(mapped);
+	size_t size=st.st_size;
+	internal::CacheFileHeader header;
+	memcpy(&header,data,sizeof(header));
+	bool found=false;
+	if (memcmp(header.magic,internal::cache_magic,sizeof(header.magic))==0 && 
+		header.key_size==key.size() && header.payload_size==size-sizeof(header)-header.key_size &&
+		key.compare(0,key.size(),data+sizeof(header),header.key_size)==0)
+	{
+		try {
+			//GiNaC reads archives from a stream, so the payload is read through a buffer over the mapped memory
+			istringstream payload(string(data+sizeof(header)+header.key_size,header.payload_size));
+			archive ar;
+			payload>>ar;
+			internal::IdRemapping remapping;
+			result=ar.unarchive_ex(known,"result");
+			found=true;
+		}
+		catch (const std::exception& e) {
+			LOG_WARN("Cannot read cached result from "<<filename<<": "<<e.what());
+		}
+	}
+	munmap(mapped,size);
+	return found;
+}
+
+void StoreCachedResult(const string& key, const ex& result)
+{
+	if (ResultCacheDirectory().empty()) return;
+	archive ar;
+	ar.archive_ex(result,"result");
+	ostringstream payload;
+	payload<<ar;
+	string data=payload.str();
+	internal::CacheFileHeader header;
+	memcpy(header.magic,internal::cache_magic,sizeof(header.magic));
+	header.key_size=key.size();
+	header.payload_size=data.size();
+	string filename=internal::CacheFileName(key);
+	//write to a temporary file and rename it, so that concurrent readers never see a partially written file
+	string temporary=filename+".tmp."+ToString(getpid());
+	int fd=open(temporary.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0666);
+	if (fd<0) {
+		LOG_WARN("Cannot write to "<<temporary);
+		return;
+	}
+	bool written=internal::WriteAll(fd,reinterpret_cast<const char*>(&header),sizeof(header)) && 
+		internal::WriteAll(fd,key.data(),key.size()) && internal::WriteAll(fd,data.data(),data.size());
+	written=(close(fd)==0) && written;
+	if (!written || rename(temporary.c_str(),filename.c_str())!=0) {
+		LOG_WARN("Cannot write to "<<filename);
+		unlink(temporary.c_str());
+	}
+}
+
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "wedge/base/wedgebase.h"
+
+/** @ingroup Base */ 
+
+/** @{ 
+ * @file resultcache.h
+ * @brief An on-disk cache for the results of expensive computations
+ *
+ * Results are stored in a directory, one file per result; files are named after a hash of a key that identifies the computation, including its 
+ * input in canonical form (see canonical_print), and contain the key itself followed by the result in %GiNaC's archive format. Files are mapped in memory 
+ * when read, and written under a temporary name and then renamed, so that several processes can share the same directory.
+ *
+ * The cache is disabled by default. Example:
+ * @code
+ * SetResultCacheDirectory("wedgecache");
+ * cout<<G.BettiNumbers()<<endl;	//computed and stored
+ * cout<<G.BettiNumbers()<<endl;	//read from the cache, also in a different run of the program
+ * @endcode
+ */
+
+namespace Wedge {
+
+using namespace GiNaC;
+using namespace std;
+
+/** @brief Enable or disable the result cache
+ * @param directory The directory where results are stored, which is created if it does not exist; the empty string disables the cache
+ */
+void SetResultCacheDirectory(const string& directory);
+
+/** @brief Return the directory where results are cached, or the empty string if the cache is disabled
+ */
+const string& ResultCacheDirectory();
+
+/** @brief Look up a result in the cache
+ * @param key A string identifying the computation and its input
+ * @param result (out) The cached result
+ * @param known A list of objects, e.g. the elements of a frame, that the result is expressed in terms of; see LoadExpressions
+ * @return true if the cache is enabled and contains a result for the given key
+ */
+bool LookupCachedResult(const string& key, ex& result, const lst& known=lst{});
+
+/** @brief Store a result in the cache, if enabled
+ * @param key A string identifying the computation and its input
+ * @param result The result to store
+ *
+ * @remark Failures to write to the cache are logged and otherwise ignored.
+ */
+void StoreCachedResult(const string& key, const ex& result);
+
+} /** @} */
+#endif
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "simplificationcache.h"
+#include <list>
+#include <unordered_map>
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+namespace internal {
+
+enum class Simplification {normal, expand};
+
+struct SimplificationKey {
+	Simplification operation;
+	ex argument;
+	bool operator==(const SimplificationKey& other) const {return operation==other.operation && argument.is_equal(other.argument);}
+};
+
+struct SimplificationKeyHash {
+	size_t operator()(const SimplificationKey& key) const {return key.argument.gethash()*2+static_cast<int>(key.operation);}
+};
+
+//rough estimate of the memory taken by an expression, not taking sharing into account
+size_t EstimateMemory(const ex& e)
+{
+	static const size_t node_size=sizeof(basic)+4*sizeof(ex);
+	size_t result=node_size;
+	for (size_t i=0;i<e.nops();++i) result+=EstimateMemory(e.op(i));
+	return result;
+}
+
+class SimplificationCache {
+	struct Entry {
+		SimplificationKey key;
+		ex result;
+		size_t memory;
+	};
+	list<Entry> entries;	//most recently used first
+	unordered_map<SimplificationKey,list<Entry>::iterator,SimplificationKeyHash> index;
+	size_t budget=0;
+	SimplificationCacheStatistics statistics;
+
+	void Evict(size_t target) {
+		while (statistics.memory>target && !entries.empty()) {
+			statistics.memory-=entries.back().memory;
+			index.erase(entries.back().key);
+			entries.pop_back();
+			++statistics.evictions;
+		}
+	}
+public:
+	void SetBudget(size_t bytes) {
+		budget=bytes;
+		Evict(budget);
+	}
+	size_t Budget() const {return budget;}
+	void Clear() {
+		index.clear();
+		entries.clear();
+		statistics.memory=0;
+	}
+	SimplificationCacheStatistics Statistics() const {
+		SimplificationCacheStatistics result=statistics;
+		result.entries=entries.size();
+		return result;
+	}
+	ex Simplify(Simplification operation, const ex& e) {
+		auto compute=[operation,&e] () {return operation==Simplification::normal? e.normal() : e.expand();};
+		if (!budget || is_a<numeric>(e) || is_a<symbol>(e)) return compute();
+		SimplificationKey key{operation,e};
+		auto i=index.find(key);
+		if (i!=index.end()) {
+			++statistics.hits;
+			entries.splice(entries.begin(),entries,i->second);
+			return i->second->result;
+		}
+		++statistics.misses;
+		ex result=compute();
+		size_t memory=EstimateMemory(e)+EstimateMemory(result);
+		if (memory>budget) return result;
+		Evict(budget-memory);
+		entries.push_front(Entry{key,result,memory});
+		index.emplace(move(key),entries.begin());
+		statistics.memory+=memory;
+		return result;
+	}
+};
+
+SimplificationCache& TheSimplificationCache()
+{
+	static SimplificationCache cache;
+	return cache;
+}
+
+}
+
+void SetSimplificationCacheBudget(size_t bytes)
+{
+	internal::TheSimplificationCache().SetBudget(bytes);
+}
+
+size_t SimplificationCacheBudget()
+{
+	return internal::TheSimplificationCache().Budget();
+}
+
+void ClearSimplificationCache()
+{
+	internal::TheSimplificationCache().Clear();
+}
+
+SimplificationCacheStatistics GetSimplificationCacheStatistics()
+{
+	return internal::TheSimplificationCache().Statistics();
+}
+
+ex CachedNormal(const ex& e)
+{
+	return internal::TheSimplificationCache().Simplify(internal::Simplification::normal,e);
+}
+
+ex CachedExpand(const ex& e)
+{
+	return internal::TheSimplificationCache().Simplify(internal::Simplification::expand,e);
+}
+
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef SIMPLIFICATIONCACHE_H
+#define SIMPLIFICATIONCACHE_H
+
+#include "wedge/base/wedgebase.h"
+
+/** @ingroup Base */ 
+
+/** @{ 
+ * @file simplificationcache.h
+ * @brief Memoization of normal() and expand()
+ *
+ * Coefficients of forms are often simplified many times over, e.g. when the same connection form is normalized after each 
+ * declaration of parameters. If a memory budget is set by SetSimplificationCacheBudget, the functions CachedNormal and CachedExpand 
+ * remember their results, evicting the least recently used ones when the budget is exceeded. 
+ */
+
+namespace Wedge {
+
+using namespace GiNaC;
+using namespace std;
+
+/** @brief Counters describing the state of the simplification cache
+ */
+struct SimplificationCacheStatistics {
+	size_t hits=0;		///< The number of calls answered from the cache
+	size_t misses=0;	///< The number of calls that required a computation
+	size_t evictions=0;	///< The number of results evicted to stay within the memory budget
+	size_t entries=0;	///< The number of results currently in the cache
+	size_t memory=0;	///< An estimate of the memory used by the cache, in bytes
+};
+
+/** @brief Set the memory budget of the simplification cache
+ * @param bytes The (approximate) maximum memory used by the cache; zero, the default, disables the cache
+ *
+ * Reducing the budget evicts results as needed.
+ */
+void SetSimplificationCacheBudget(size_t bytes);
+
+/** @brief Return the memory budget of the simplification cache, or zero if the cache is disabled
+ */
+size_t SimplificationCacheBudget();
+
+/** @brief Remove all results from the simplification cache; counters are not affected
+ */
+void ClearSimplificationCache();
+
+/** @brief Return the counters of the simplification cache
+ */
+SimplificationCacheStatistics GetSimplificationCacheStatistics();
+
+/** @brief Equivalent to e.normal(), but uses the simplification cache if enabled
+ */
+ex CachedNormal(const ex& e);
+
+/** @brief Equivalent to e.expand(), but uses the simplification cache if enabled
+ */
+ex CachedExpand(const ex& e);
+
+} /** @} */
+#endif
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "straightlineprogram.h"
+#include "wedge/base/wexception.h"
+#include <climits>
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+namespace internal {
+
+//compiles expressions into instructions whose registers are "virtual", i.e. each instruction writes a new register
+class StraightLineProgramCompiler {
+	typedef StraightLineProgram::Opcode Opcode;
+	typedef StraightLineProgram::Instruction Instruction;
+	StraightLineProgram& program;
+	int virtual_registers;
+	map<ex,int,ex_is_less> compiled;	//subexpressions already computed, and the register holding them
+
+	int Emit(Opcode op, int x=0, int y=0, complex<double> constant=0) {
+		Instruction instruction;
+		instruction.op=op;
+		instruction.result=virtual_registers++;
+		instruction.x=x;
+		instruction.y=y;
+		instruction.constant=constant;
+		program.code.push_back(instruction);
+		return instruction.result;
+	}
+	int Constant(const ex& value) {
+		ex x=value.evalf();
+		if (!is_a<numeric>(x)) throw InvalidArgument(__FILE__,__LINE__,value);
+		const numeric& n=ex_to<numeric>(x);
+		complex<double> c(n.real().to_double(),n.imag().to_double());
+		if (c.imag()!=0) program.has_complex_constants=true;
+		return Emit(Opcode::Constant,0,0,c);
+	}
+	int IntegerPower(int x, long n) {
+		if (n<0) return Emit(Opcode::Inverse,IntegerPower(x,-n));
+		if (n==0) return Constant(1);
+		int result=-1;
+		while (true) {
+			if (n&1) result=result<0? x : Emit(Opcode::Multiply,result,x);
+			n>>=1;
+			if (!n) return result;
+			x=Emit(Opcode::Multiply,x,x);
+		}
+	}
+	int CompileFunction(const ex& e) {
+		static const vector<pair<unsigned,Opcode>> functions {
+			{sin_SERIAL::serial,Opcode::Sin}, {cos_SERIAL::serial,Opcode::Cos}, {tan_SERIAL::serial,Opcode::Tan},
+			{exp_SERIAL::serial,Opcode::Exp}, {log_SERIAL::serial,Opcode::Log},
+			{sinh_SERIAL::serial,Opcode::Sinh}, {cosh_SERIAL::serial,Opcode::Cosh}, {tanh_SERIAL::serial,Opcode::Tanh},
+			{asin_SERIAL::serial,Opcode::Asin}, {acos_SERIAL::serial,Opcode::Acos}, {atan_SERIAL::serial,Opcode::Atan},
+			{abs_SERIAL::serial,Opcode::Abs}
+		};
+		unsigned serial=ex_to<function>(e).get_serial();
+		for (auto& f: functions)
+			if (f.first==serial && e.nops()==1) return Emit(f.second,Compile(e.op(0)));
+		throw InvalidArgument(__FILE__,__LINE__,e);
+	}
+public:
+	StraightLineProgramCompiler(StraightLineProgram& program, const exvector& variables) : program(program), virtual_registers(variables.size()) {
+		program.variables=variables.size();
+		for (int i=0;i<variables.size();++i)
+			if (!compiled.emplace(variables[i],i).second) throw InvalidArgument(__FILE__,__LINE__,variables[i]);
+	}
+	int Compile(const ex& e) {
+		auto i=compiled.find(e);
+		if (i!=compiled.end()) return i->second;
+		int result;
+		if (is_a<numeric>(e) || is_a<constant>(e)) result=Constant(e);
+		else if (is_a<add>(e) || is_a<mul>(e)) {
+			Opcode op=is_a<add>(e)? Opcode::Add : Opcode::Multiply;
+			result=Compile(e.op(0));
+			for (int j=1;j<e.nops();++j)
+				result=Emit(op,result,Compile(e.op(j)));
+		}
+		else if (is_a<power>(e)) {
+			ex exponent=e.op(1);
+			int base=Compile(e.op(0));
+			if (exponent.info(info_flags::integer)) result=IntegerPower(base,ex_to<numeric>(exponent).to_long());
+			else if (is_a<numeric>(exponent) && exponent.info(info_flags::real))
+				result=Emit(Opcode::PowerConstant,base,0,ex_to<numeric>(exponent).to_double());
+			else result=Emit(Opcode::Power,base,Compile(exponent));
+		}
+		else if (is_a<function>(e)) result=CompileFunction(e);
+		else throw InvalidArgument(__FILE__,__LINE__,e);
+		compiled.emplace(e,result);
+		return result;
+	}
+	//replace virtual registers with physical ones, reusing a register as soon as its last use has been reached
+	void AllocateRegisters() {
+		auto uses_x=[] (const Instruction& instruction) {return instruction.op!=Opcode::Constant;};
+		auto uses_y=[] (const Instruction& instruction) {
+			return instruction.op==Opcode::Add || instruction.op==Opcode::Multiply || instruction.op==Opcode::Power;
+		};
+		vector<int> last_use(virtual_registers,-1);
+		for (int k=0;k<program.code.size();++k) {
+			if (uses_x(program.code[k])) last_use[program.code[k].x]=k;
+			if (uses_y(program.code[k])) last_use[program.code[k].y]=k;
+		}
+		for (int r: program.outputs) last_use[r]=INT_MAX;
+		vector<int> physical(virtual_registers);
+		vector<int> available;
+		int registers=program.variables;
+		for (int r=0;r<program.variables;++r) {
+			physical[r]=r;
+			if (last_use[r]<0) available.push_back(r);
+		}
+		for (int k=0;k<program.code.size();++k) {
+			Instruction& instruction=program.code[k];
+			if (uses_x(instruction) && last_use[instruction.x]==k) available.push_back(physical[instruction.x]);
+			if (uses_y(instruction) && instruction.y!=instruction.x && last_use[instruction.y]==k) available.push_back(physical[instruction.y]);
+			instruction.x=uses_x(instruction)? physical[instruction.x] : 0;
+			instruction.y=uses_y(instruction)? physical[instruction.y] : 0;
+			if (available.empty()) physical[instruction.result]=registers++;
+			else {
+				physical[instruction.result]=available.back();
+				available.pop_back();
+			}
+			instruction.result=physical[instruction.result];
+		}
+		for (int& r: program.outputs) r=physical[r];
+		program.registers=registers;
+	}
+};
+
+template<typename Scalar> Scalar ConstantAs(complex<double> c);
+template<> double ConstantAs<double>(complex<double> c) {return c.real();}
+template<> complex<double> ConstantAs<complex<double>>(complex<double> c) {return c;}
+
+//apply f to each point in a block; the loop is over the points, so that it can be vectorized
+template<typename F> inline void ForEachLane(int lanes, F&& f) {
+	for (int l=0;l<lanes;++l) f(l);
+}
+}
+
+StraightLineProgram::StraightLineProgram(const exvector& variables, const exvector& outputs)
+{
+	internal::StraightLineProgramCompiler compiler(*this,variables);
+	for (auto& output: outputs)
+		this->outputs.push_back(compiler.Compile(output));
+	compiler.AllocateRegisters();
+}
+
+template<typename Scalar> vector<Scalar> StraightLineProgram::Evaluate(const vector<Scalar>& points) const
+{
+	if (is_same<Scalar,double>::value && has_complex_constants) 
+		throw WedgeException<std::invalid_argument>("Complex coefficients cannot be evaluated in double precision",__FILE__,__LINE__);
+	if (variables? points.size()%variables : points.size()>0)
+		throw WedgeException<std::invalid_argument>("Number of coordinates not a multiple of the number of variables",__FILE__,__LINE__);
+	const int batch=variables? points.size()/variables : 1;
+	vector<Scalar> result(batch*outputs.size());
+	vector<Scalar> r(registers*BlockSize);
+	for (int start=0;start<batch;start+=BlockSize) {
+		const int lanes=min(BlockSize,batch-start);
+		for (int v=0;v<variables;++v)
+			for (int l=0;l<lanes;++l)
+				r[v*BlockSize+l]=points[(start+l)*variables+v];
+		for (auto& instruction: code) {
+			Scalar* out=&r[instruction.result*BlockSize];
+			const Scalar* x=&r[instruction.x*BlockSize];
+			const Scalar* y=&r[instruction.y*BlockSize];
+			switch (instruction.op) {
+			case Opcode::Constant: {
+				Scalar c=internal::ConstantAs<Scalar>(instruction.constant);
+				internal::ForEachLane(lanes,[out,c] (int l) {out[l]=c;});
+				break;
+			}
+			case Opcode::Add: internal::ForEachLane(lanes,[out,x,y] (int l) {out[l]=x[l]+y[l];}); break;
+			case Opcode::Multiply: internal::ForEachLane(lanes,[out,x,y] (int l) {out[l]=x[l]*y[l];}); break;
+			case Opcode::Inverse: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=Scalar(1)/x[l];}); break;
+			case Opcode::Power: internal::ForEachLane(lanes,[out,x,y] (int l) {out[l]=std::pow(x[l],y[l]);}); break;
+			case Opcode::PowerConstant: {
+				double exponent=instruction.constant.real();
+				if (exponent==0.5) internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::sqrt(x[l]);});
+				else internal::ForEachLane(lanes,[out,x,exponent] (int l) {out[l]=std::pow(x[l],exponent);});
+				break;
+			}
+			case Opcode::Sin: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::sin(x[l]);}); break;
+			case Opcode::Cos: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::cos(x[l]);}); break;
+			case Opcode::Tan: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::tan(x[l]);}); break;
+			case Opcode::Exp: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::exp(x[l]);}); break;
+			case Opcode::Log: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::log(x[l]);}); break;
+			case Opcode::Sinh: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::sinh(x[l]);}); break;
+			case Opcode::Cosh: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::cosh(x[l]);}); break;
+			case Opcode::Tanh: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::tanh(x[l]);}); break;
+			case Opcode::Asin: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::asin(x[l]);}); break;
+			case Opcode::Acos: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::acos(x[l]);}); break;
+			case Opcode::Atan: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=std::atan(x[l]);}); break;
+			case Opcode::Abs: internal::ForEachLane(lanes,[out,x] (int l) {out[l]=Scalar(std::abs(x[l]));}); break;
+			}
+		}
+		for (int o=0;o<outputs.size();++o)
+			for (int l=0;l<lanes;++l)
+				result[(start+l)*outputs.size()+o]=r[outputs[o]*BlockSize+l];
+	}
+	return result;
+}
+
+template vector<double> StraightLineProgram::Evaluate<double>(const vector<double>& points) const;
+template vector<complex<double>> StraightLineProgram::Evaluate<complex<double>>(const vector<complex<double>>& points) const;
+
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef STRAIGHTLINEPROGRAM_H
+#define STRAIGHTLINEPROGRAM_H
+
+#include "wedge/base/wedgealgebraic.h"
+#include <complex>
+
+/** @ingroup Base */ 
+
+/** @{ 
+ * @file straightlineprogram.h
+ * @brief Numerical evaluation of expressions at batches of points
+ */
+
+namespace Wedge {
+
+using namespace GiNaC;
+using namespace std;
+
+namespace internal {
+	class StraightLineProgramCompiler;
+}
+
+/** @brief A list of expressions compiled into a straight-line program, for fast numerical evaluation
+ *
+ * Each subexpression occurring in the expressions is computed once, and the value of each instruction is computed for 
+ * a block of points at a time, so that the inner loops run over the points and can be vectorized by the compiler. 
+ * Registers are reused as soon as their values are no longer needed.
+ *
+ * The expressions may contain the variables, numbers, constants such as Pi, sums, products, powers and the functions 
+ * sin, cos, tan, exp, log, sinh, cosh, tanh, asin, acos, atan and abs.
+ */
+class StraightLineProgram {
+public:
+	static constexpr int BlockSize=64;	///< The number of points processed by each instruction in one go
+
+/** @brief Construct an empty program, with no variables and no outputs
+ */
+	StraightLineProgram() {}
+/** @brief Compile a list of expressions
+ * @param variables The symbols (or functions such as ManifoldWithCoordinates::x()) the expressions depend on
+ * @param outputs The expressions to evaluate
+ * @exception InvalidArgument if an expression contains an object which is neither a variable nor supported
+ */
+	StraightLineProgram(const exvector& variables, const exvector& outputs);
+
+	int Variables() const {return variables;}	///< The number of variables
+	int Outputs() const {return outputs.size();}	///< The number of expressions
+	int Instructions() const {return code.size();}	///< The number of instructions, after eliminating common subexpressions
+	int Registers() const {return registers;}	///< The number of registers, each holding a value for BlockSize points
+
+/** @brief Evaluate the expressions at a batch of points
+ * @param points The coordinates of the points, Variables() for each point; if there are no variables, a single point is assumed
+ * @return The values of the expressions, Outputs() for each point
+ * @exception WedgeException<std::invalid_argument> if the size of points is not a multiple of Variables(), or 
+ * if Scalar is double and the expressions have complex coefficients
+ *
+ * Scalar may be double or complex<double>.
+ */
+	template<typename Scalar> vector<Scalar> Evaluate(const vector<Scalar>& points) const;
+private:
+	enum class Opcode {Constant, Add, Multiply, Inverse, Power, PowerConstant, Sin, Cos, Tan, Exp, Log, Sinh, Cosh, Tanh, Asin, Acos, Atan, Abs};
+	struct Instruction {
+		Opcode op;
+		int result, x=0, y=0;	///< registers
+		complex<double> constant;	///< The value of a Constant, or the exponent of a PowerConstant
+	};
+	int variables=0;
+	int registers=0;
+	vector<Instruction> code;
+	vector<int> outputs;	//registers holding the outputs at the end of the program
+	bool has_complex_constants=false;
+	friend class internal::StraightLineProgramCompiler;
+};
+
+} /** @} */
+#endif
@@ -29,24 +29,65 @@ const unsigned TINFO_LambdaVector =TINFO_ncmul|WEDGE_TINFO_INCREMENT;
 unsigned internal::TInfoHelper::TINFO_Last= WEDGE_TINFO_INCREMENT;
 #endif
 
-#if (GINACLIB_MAJOR_VERSION<=1) && (GINACLIB_MINOR_VERSION<=4)
-void Vector::archive(GiNaC::archive_node &n) const {}
-GiNaC::ex Vector::unarchive(const GiNaC::archive_node &n, GiNaC::lst &sym_lst)
+
+
+namespace internal {
+
+static map<string,UnarchiveFunction>& UnarchiveFunctions()
 {
-	assert(false);
-	return 0;
+	static map<string,UnarchiveFunction> unarchive_functions;
+	return unarchive_functions;
 }
-#endif
 
-#if (GINACLIB_MAJOR_VERSION<=1) && (GINACLIB_MINOR_VERSION<=4)
-void LambdaVector::archive(GiNaC::archive_node &n) const {}
-GiNaC::ex LambdaVector::unarchive(const GiNaC::archive_node &n, GiNaC::lst &sym_lst)
+/* Placeholder object created by GiNaC when unarchiving a Wedge class; it is replaced by the actual object 
+ * when it is first evaluated, i.e. when GiNaC converts it to an ex.
+ */
+class ArchivedObject : public basic {
+	ex object;
+public:
+	static basic* create() {return new ArchivedObject;}
+	void read_archive(const archive_node& n, lst& sym_lst) override
+	{
+		//each Registered class in the hierarchy stores its type name, the most derived one last
+		string type_name, last;
+		for (int i=0;n.find_string("wedge_type",type_name,i);++i) last=type_name;
+		auto f=UnarchiveFunctions().find(last);
+		if (f==UnarchiveFunctions().end()) 
+			throw WedgeException<std::runtime_error>("No unarchive function defined for type "+last,__FILE__,__LINE__);
+		object=f->second(n,sym_lst);
+	}
+	ex eval() const override {return object;}
+};
+
+void RegisterUnarchiveFunction(const char* class_name, const char* type_name, UnarchiveFunction f)
 {
-	assert(false);
-	return 0;
+	static GiNaC::unarchive_table_t table;
+	static set<string> class_names;
+	if (class_names.insert(class_name).second)
+		table.insert(class_name,&ArchivedObject::create);
+	UnarchiveFunctions()[type_name]=f;
+}
+
+void ArchiveTypeName(archive_node& n, const char* type_name)
+{
+	n.add_string("wedge_type",type_name);
 }
-#endif
 
+IdRemapping* IdRemapping::current=nullptr;
+
+unsigned IdRemapping::Restore(const char* type_name, unsigned archived, unsigned fresh)
+{
+	if (current==nullptr) return archived;
+	auto inserted=current->ids.insert(make_pair(make_pair(string(type_name),archived),fresh));
+	return inserted.first->second;
+}
+
+void IdRemapping::Identify(const char* type_name, unsigned archived, unsigned id)
+{
+	if (current!=nullptr) current->ids[make_pair(string(type_name),archived)]=id;
+}
+
+}
 
 
 PredefinedNames::PredefinedNames() : alpha("alpha","\\alpha"), beta("beta","\\beta"), gamma ("gamma", "\\gamma"), Gamma ("Gamma", "\\Gamma"), delta ("delta", "\\delta"), 
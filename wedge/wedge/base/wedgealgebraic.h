@@ -32,7 +32,7 @@ The template can also be instructed to implement additional "attributes". There
 
 In order to handle attributes (considering the cases where one derives from a class which is either a Registered itself, or a GiNaC class which implements either attribute), the template instance to derive is given as a member of another template class call Register.
 
-@note Registered does not provide a general method to define classes with archiving support (though one can always add archiving support ''by hand'' if needed).
+@note Registered implements archiving of the attributes (name and ID); classes containing additional data should overload archive and read_archive, calling the inherited versions first.
  
 To define an Algebraic class follow these steps:
  - derive your class from Registered, as in class YourClass : public Register<YourClass, basic>::Algebraic
@@ -54,6 +54,8 @@ which defines a Numbered algebraic class named classname and derived from superc
 #include "wedge/base/logging.h"
 #include "wedge/convenience/parse.h"
 #include "wedge/convenience/named.h"
+#include <typeinfo>
+#include <type_traits>
 
 /* @brief Defines a Numbered algebraic class named classname and derived from superclass.
  * 
@@ -127,6 +129,57 @@ template<> struct ForwardName<false> {
 	}
 };
 
+namespace internal {
+
+/* %GiNaC identifies the class of an archived object by its class name, which in %Wedge is shared by all the instances of a template
+ * (e.g. Lambda<VectorField> and Lambda<VectorSpace<V>::Coordinate> are both called Lambda). Registered classes also store the
+ * name of their C++ type, and the actual object is created by the unarchive function registered under that name.
+ */
+typedef ex (*UnarchiveFunction)(const archive_node& n, lst& sym_lst);
+void RegisterUnarchiveFunction(const char* class_name, const char* type_name, UnarchiveFunction f);
+void ArchiveTypeName(archive_node& n, const char* type_name);
+
+template<typename T> ex Unarchive(const archive_node& n, lst& sym_lst)
+{
+	if constexpr (std::is_default_constructible<T>::value) {
+		T* object=new T;
+		object->setflag(status_flags::dynallocated);
+		object->read_archive(n,sym_lst);
+		return *object;
+	}
+	else throw WedgeException<std::runtime_error>(string("Objects of type ")+T::static_class_name()+" cannot be unarchived",__FILE__,__LINE__);
+}
+
+template<typename T> struct UnarchiveRegistration {
+	UnarchiveRegistration() {RegisterUnarchiveFunction(T::static_class_name(),typeid(T).name(),&Unarchive<T>);}
+};
+
+/* Determines how the identity of unarchived objects (i.e. the ID of Numbered classes and the serial number of symbols) is restored.
+ * By default the archived values are kept, which is correct when the archive was created by a process forked from the current one, 
+ * e.g. a worker in a WorkerPool. While an IdRemapping object exists, each archived value is mapped instead to a fresh value, 
+ * consistently for all objects unarchived during its lifetime; this is needed for archives written by a different run. 
+ */
+class IdRemapping {
+	static IdRemapping* current;
+	IdRemapping* previous;
+	map<pair<string,unsigned>,unsigned> ids;
+public:
+	IdRemapping() {previous=current; current=this;}
+	IdRemapping(const IdRemapping&)=delete;
+	~IdRemapping() {current=previous;}
+/* @brief Return the identity of an unarchived object
+ * @param type_name The type of the object, distinguishing unrelated sequences of IDs
+ * @param archived The value stored in the archive
+ * @param fresh A value not used by any other object, to be used if the archived value is met for the first time
+ */
+	static unsigned Restore(const char* type_name, unsigned archived, unsigned fresh);
+/* @brief Record the identity of an unarchived object that has been identified with an existing object
+ */
+	static void Identify(const char* type_name, unsigned archived, unsigned id);
+};
+
+}
+
 template<typename subclass,typename supername> class Registered<subclass,supername,false,false> : public supername {
 //constructors
 public:
@@ -138,6 +191,7 @@ protected:
 	typedef Registered<subclass,supername,false,false> RegClass;
 private:
 	static GiNaC::registered_class_info reg_info;		
+	static internal::UnarchiveRegistration<subclass> unarchive_registration;
 public:
 	typedef supername inherited; 
 	static GiNaC::registered_class_info &get_class_info_static() { return reg_info; } 		
@@ -164,6 +218,11 @@ public:
 		return this->compare_same_type(other)==0;
 	}
 	static const char* static_class_name() {throw WedgeException<std::logic_error>("Member static_class_name not defined",__FILE__,__LINE__);}
+	void archive(archive_node& n) const override {
+		inherited::archive(n);
+		(void) &unarchive_registration;
+		internal::ArchiveTypeName(n,typeid(subclass).name());
+	}
 };
 
 template<typename subclass,typename supername> class Registered<subclass,supername,true,false> : public supername {
@@ -178,6 +237,7 @@ protected:
 	typedef Registered<subclass,supername,true,false> RegClass;
 private:
 	static GiNaC::registered_class_info reg_info;		
+	static internal::UnarchiveRegistration<subclass> unarchive_registration;
 public:
 	typedef supername inherited; 
 	static GiNaC::registered_class_info &get_class_info_static() { return reg_info; } 		
@@ -204,6 +264,17 @@ public:
 		return this->compare_same_type(other)==0;
 	}
 	static const char* static_class_name() {throw WedgeException<std::logic_error>("Member static_class_name not defined",__FILE__,__LINE__);}
+	void archive(archive_node& n) const override {
+		inherited::archive(n);
+		(void) &unarchive_registration;
+		n.add_unsigned("id",ID);
+		internal::ArchiveTypeName(n,typeid(subclass).name());
+	}
+	void read_archive(const archive_node& n, lst& sym_lst) override {
+		inherited::read_archive(n,sym_lst);
+		unsigned id;
+		if (n.find_unsigned("id",id)) ID=internal::IdRemapping::Restore(typeid(subclass).name(),id,ID);
+	}
 //implements Numbered
 protected:
 	int ID;				//object ID
@@ -237,6 +308,7 @@ protected:
 	typedef Registered<subclass,supername,true,true> RegClass;
 private:
 	static GiNaC::registered_class_info reg_info;		
+	static internal::UnarchiveRegistration<subclass> unarchive_registration;
 public:
 	typedef supername inherited; 
 	static GiNaC::registered_class_info &get_class_info_static() { return reg_info; } 		
@@ -263,6 +335,31 @@ public:
 		return compare_same_type(other)==0;
 	}
 	static const char* static_class_name() {throw WedgeException<std::logic_error>("Member static_class_name not defined",__FILE__,__LINE__);}
+	void archive(archive_node& n) const override {
+		inherited::archive(n);
+		(void) &unarchive_registration;
+		n.add_unsigned("id",ID);
+		n.add_string("name",name);
+		n.add_string("TeX_name",TeX_name);
+		internal::ArchiveTypeName(n,typeid(subclass).name());
+	}
+	void read_archive(const archive_node& n, lst& sym_lst) override {
+		inherited::read_archive(n,sym_lst);
+		n.find_string("name",name);
+		n.find_string("TeX_name",TeX_name);
+		unsigned id;
+		if (!n.find_unsigned("id",id)) return;
+		//as with GiNaC symbols, an object in sym_lst with the same name and type is identified with the archived object
+		for (auto& x: sym_lst) {
+			const subclass* known=dynamic_cast<const subclass*>(&ex_to<basic>(x));
+			if (known!=nullptr && known->get_name()==name) {
+				ID=static_cast<const Registered&>(*known).ID;
+				internal::IdRemapping::Identify(typeid(subclass).name(),id,ID);
+				return;
+			}
+		}
+		ID=internal::IdRemapping::Restore(typeid(subclass).name(),id,ID);
+	}
 //implements Numbered
 protected:
 	int ID;				//object ID
@@ -312,6 +409,7 @@ protected:
 	typedef Registered<subclass,supername,false,true> RegClass;
 private:
 	static GiNaC::registered_class_info reg_info;		
+	static internal::UnarchiveRegistration<subclass> unarchive_registration;
 public:
 	typedef supername inherited; 
 	static GiNaC::registered_class_info &get_class_info_static() { return reg_info; } 		
@@ -338,6 +436,18 @@ public:
 		return compare_same_type(other)==0;
 	}
 	static const char* static_class_name() {throw WedgeException<std::logic_error>("Member static_class_name not defined",__FILE__,__LINE__);}
+	void archive(archive_node& n) const override {
+		inherited::archive(n);
+		(void) &unarchive_registration;
+		n.add_string("name",name);
+		n.add_string("TeX_name",TeX_name);
+		internal::ArchiveTypeName(n,typeid(subclass).name());
+	}
+	void read_archive(const archive_node& n, lst& sym_lst) override {
+		inherited::read_archive(n,sym_lst);
+		n.find_string("name",name);
+		n.find_string("TeX_name",TeX_name);
+	}
 //implements Named	
 	virtual void print(const print_context &c, unsigned level= 0) const {
 		if (dynamic_cast<const print_latex*>(&c)!=NULL)
@@ -371,6 +481,7 @@ protected:
 	typedef RegisteredSymbol<subclass,supername> RegClass;
 private:
 	static GiNaC::registered_class_info reg_info;		
+	static internal::UnarchiveRegistration<subclass> unarchive_registration;
 public:
 	typedef supername inherited; 
 	static GiNaC::registered_class_info &get_class_info_static() { return reg_info; } 		
@@ -397,6 +508,22 @@ public:
 		return this->compare_same_type(other)==0;
 	}
 	static const char* static_class_name() {throw WedgeException<std::logic_error>("Member static_class_name not defined",__FILE__,__LINE__);}
+	void archive(archive_node& n) const override {
+		inherited::archive(n);
+		(void) &unarchive_registration;
+		n.add_unsigned("serial",this->serial);
+		internal::ArchiveTypeName(n,typeid(subclass).name());
+	}
+	void read_archive(const archive_node& n, lst& sym_lst) override {
+		inherited::read_archive(n,sym_lst);	//identifies this object with a symbol in sym_lst having the same name, if any
+		for (auto& x: sym_lst)
+			if (is_a<symbol>(x) && ex_to<symbol>(x).get_name()==this->get_name()) return;
+		unsigned archived;
+		if (n.find_unsigned("serial",archived)) {
+			this->serial=internal::IdRemapping::Restore("symbol",archived,this->serial);
+			this->clearflag(status_flags::hash_calculated);
+		}
+	}
 //implements Named	
 	string get_tex_name() const {return this->TeX_name;}
 };
@@ -449,6 +576,12 @@ template<> struct VisitorClass<possymbol> : VisitorClass<symbol> {};
 template<typename subclass,typename supername> int Registered<subclass,supername,true,false>::lastID;
 template<typename subclass,typename supername> int Registered<subclass,supername,true,true>::lastID;
 
+template<typename subclass,typename superclass> internal::UnarchiveRegistration<subclass> Registered<subclass,superclass,true,true>::unarchive_registration;
+template<typename subclass,typename superclass> internal::UnarchiveRegistration<subclass> Registered<subclass,superclass,true,false>::unarchive_registration;
+template<typename subclass,typename superclass> internal::UnarchiveRegistration<subclass> Registered<subclass,superclass,false,true>::unarchive_registration;
+template<typename subclass,typename superclass> internal::UnarchiveRegistration<subclass> Registered<subclass,superclass,false,false>::unarchive_registration;
+template<typename subclass,typename superclass> internal::UnarchiveRegistration<subclass> RegisteredSymbol<subclass,superclass>::unarchive_registration;
+
 // The following serves the same purpose as GINAC_IMPLEMENT_REGISTERED_CLASS(subclass,superclass);
 template<typename subclass,typename superclass> 
   GiNaC::registered_class_info Registered<subclass,superclass,true,true>::reg_info =
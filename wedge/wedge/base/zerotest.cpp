@@ -0,0 +1,151 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "wedgebase.h"
+#include "zerotest.h"
+#include "logging.h"
+#include <random>
+#include <cstdint>
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+namespace internal {
+
+//evaluation of rational functions at a point modulo the prime 2^61-1
+class ModularEvaluator {
+public:
+	enum Status {ok, unsupported, singular};
+	static const uint64_t p=(uint64_t(1)<<61)-1;
+
+	ModularEvaluator(mt19937_64& generator) : generator(generator) {}
+
+	Status Evaluate(const ex& e, uint64_t& value)
+	{
+		if (is_a<numeric>(e)) return Evaluate(ex_to<numeric>(e),value);
+		else if (is_a<symbol>(e)) {
+			auto i=point.find(e);
+			if (i==point.end()) i=point.emplace(e,generator()%p).first;
+			value=i->second;
+			return ok;
+		}
+		else if (is_a<add>(e) || is_a<mul>(e)) {
+			bool is_add=is_a<add>(e);
+			value=is_add? 0 : 1;
+			for (size_t i=0;i<e.nops();++i) {
+				uint64_t x;
+				Status status=Evaluate(e.op(i),x);
+				if (status!=ok) return status;
+				value=is_add? Add(value,x) : Multiply(value,x);
+			}
+			return ok;
+		}
+		else if (is_a<power>(e) && e.op(1).info(info_flags::integer)) {
+			uint64_t base;
+			Status status=Evaluate(e.op(0),base);
+			if (status!=ok) return status;
+			const numeric& n=ex_to<numeric>(e.op(1));
+			if (n.is_negative()) {
+				if (base==0) return singular;
+				base=Inverse(base);
+			}
+			value=Power(base,abs(n));
+			return ok;
+		}
+		else return unsupported;
+	}
+private:
+	mt19937_64& generator;
+	map<ex,uint64_t,ex_is_less> point;
+
+	static uint64_t Add(uint64_t x, uint64_t y) {return (x+y)%p;}
+	static uint64_t Multiply(uint64_t x, uint64_t y) {return static_cast<uint64_t>((static_cast<unsigned __int128>(x)*y)%p);}
+	static uint64_t Power(uint64_t x, numeric n)
+	{
+		uint64_t result=1;
+		n=mod(n,p-1);	//by Fermat's little theorem, if x is nonzero
+		if (n.is_zero()) return x==0? 0 : 1;
+		uint64_t k=n.to_long();
+		while (k) {
+			if (k&1) result=Multiply(result,x);
+			x=Multiply(x,x);
+			k>>=1;
+		}
+		return result;
+	}
+	static uint64_t Inverse(uint64_t x) {return Power(x,numeric(static_cast<long>(p-2)));}
+
+	Status Evaluate(const numeric& n, uint64_t& value)
+	{
+		if (!n.is_rational()) return unsupported;
+		static const numeric modulus(static_cast<long>(p));
+		uint64_t numer=mod(n.numer(),modulus).to_long(), denom=mod(n.denom(),modulus).to_long();
+		if (denom==0) return unsupported;	//a coefficient is not defined modulo p
+		value=Multiply(numer,Inverse(denom));
+		return ok;
+	}
+};
+
+int& RandomizedZeroTestingSamples()
+{
+	static int samples=0;
+	return samples;
+}
+
+}
+
+bool ProbablyZero(ex e, int samples)
+{
+	static mt19937_64 generator;
+	int tested=0, attempts=0;
+	while (tested<samples && attempts<3*samples) {
+		++attempts;
+		internal::ModularEvaluator evaluator(generator);
+		uint64_t value;
+		auto status=evaluator.Evaluate(e,value);
+		if (status==internal::ModularEvaluator::unsupported) break;
+		else if (status==internal::ModularEvaluator::ok) {
+			if (value!=0) return false;
+			++tested;
+		}
+	}
+	if (tested==samples) return true;
+	LOG_DEBUG(e);
+	return e.normal().is_zero();
+}
+
+void SetRandomizedZeroTesting(int samples)
+{
+	if (samples<0) throw OutOfRange(__FILE__,__LINE__,samples);
+	internal::RandomizedZeroTestingSamples()=samples;
+}
+
+int RandomizedZeroTesting()
+{
+	return internal::RandomizedZeroTestingSamples();
+}
+
+bool CoefficientIsZero(ex e)
+{
+	int samples=RandomizedZeroTesting();
+	return samples? ProbablyZero(e,samples) : e.numer().expand().is_zero();
+}
+
+}
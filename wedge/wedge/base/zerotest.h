@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef ZEROTEST_H
+#define ZEROTEST_H
+
+#include "wedge/base/wedgebase.h"
+
+/** @ingroup Base */ 
+
+/** @{ 
+ * @file zerotest.h
+ * @brief Randomized zero testing of rational functions
+ *
+ * Deciding whether a rational function in many parameters is zero by expanding or normalizing it can be expensive. By the Schwartz-Zippel lemma, 
+ * a nonzero rational function of degree at most \f$k\f$ evaluated at a random point modulo a prime \f$p\f$ vanishes with probability at most \f$k/p\f$; 
+ * evaluating at a few random points modulo \f$p=2^{61}-1\f$ thus decides whether the function is zero with negligible probability of error.
+ * A nonzero value proves that the function is nonzero.
+ */
+
+namespace Wedge {
+
+using namespace GiNaC;
+using namespace std;
+
+/** @brief Test whether an expression is zero by evaluating it at random points modulo a large prime
+ * @param e An expression
+ * @param samples The number of random points
+ * @return false if e is nonzero, true if e is zero with high probability
+ *
+ * If e is not a rational function with rational coefficients in its symbols (e.g. it contains a square root), or the evaluation fails 
+ * because a denominator vanishes at too many points, the exact test e.normal().is_zero() is used instead.
+ */
+bool ProbablyZero(ex e, int samples=3);
+
+/** @brief Enable randomized zero testing in the zero tests performed internally by %Wedge
+ * @param samples The number of random points to be used by ProbablyZero; zero, the default, means that zero tests are exact
+ *
+ * This affects the computation of components relative to a basis, VSpace::Contains, NormalForm and Manifold::Check_ddZero.
+ */
+void SetRandomizedZeroTesting(int samples);
+
+/** @brief Return the number of random points used by internal zero tests, or zero if zero tests are exact
+ */
+int RandomizedZeroTesting();
+
+/** @brief Test whether a coefficient is zero, using ProbablyZero if randomized zero testing is enabled and an exact test otherwise
+ * @param e A scalar expression
+ */
+bool CoefficientIsZero(ex e);
+
+} /** @} */
+#endif
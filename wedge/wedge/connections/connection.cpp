@@ -26,8 +26,28 @@
 #include "wedge/connections/torsionfreeconnection.h"
 #include "wedge/manifolds/manifold.h"
 #include "wedge/linearalgebra/tensor.h"
+#include "wedge/base/parallel.h"
+#include "wedge/base/resultcache.h"
+#include "wedge/liealgebras/liegroup.h"
 
 namespace Wedge {
+
+//the symbols appearing in the connection form, needed to reconstruct the results of ParallelMap
+static lst SymbolsIn(const vector<exvector>& components)
+{
+	lst symbols;
+	for (auto& row : components)
+		for (auto& x : row)
+			CollectSymbols(x,symbols);
+	return symbols;
+}
+
+//the manifold as a Lie group whose results can be cached, or null if the cache is disabled or the manifold is not a Lie group without parameters
+static const LieGroupHasParameters<false>* CachingLieGroup(const Manifold* manifold)
+{
+	if (ResultCacheDirectory().empty()) return nullptr;
+	return dynamic_cast<const LieGroupHasParameters<false>*>(manifold);
+}
  
 ////////////////////////////////////////////////////////////
 //			Connection						 
@@ -63,7 +83,7 @@ matrix Connection::AsMatrix() const
 	matrix m(dimension,dimension);
 	for (int i=0;i<dimension;i++)
 		for (int j=0;j<dimension;j++)
-			m(i,j)=components[i][j].normal();
+			m(i,j)=CachedNormal(components[i][j]);
 	return m;
 }
 
@@ -84,28 +104,51 @@ matrix Connection::RicciAsMatrix() const
 {
 	LOG_DEBUG(e());
 	LOG_DEBUG(e().dual());	
+	const int dimension=e().size();
+	auto G=CachingLieGroup(manifold);
+	string key;
+	lst known;
+	if (G) {
+		exvector input(e().begin(),e().end());
+		for (auto& row : components)
+			input.insert(input.end(),row.begin(),row.end());
+		key=G->CacheKey("RicciAsMatrix",input);
+		known=SymbolsIn(components);
+		CollectSymbols(lst(e().begin(),e().end()),known);
+		CollectSymbols(lst(manifold->e().begin(),manifold->e().end()),known);
+		ex cached;
+		if (LookupCachedResult(key,cached,known) && is_a<matrix>(cached)) return ex_to<matrix>(cached);
+	}
 	matrix R=CurvatureForm();
-	matrix ric(e().size(),e().size());	
-	for (int j=0;j<e().size();++j) {
+	matrix ric(dimension,dimension);
+	lst symbols;
+	CollectSymbols(R,symbols);
+	exvector columns=ParallelMap(dimension,[this,&R,dimension] (int j) {
 		ex sum;
-		for (int i=0;i<e().size();++i)
+		for (int i=0;i<dimension;++i)
 			sum+=Hook(e().dual()[i],R(i,j));
-		for (int k=0;k<e().size();++k)
-			ric(k,j)=Hook(e().dual()[k],sum);
-	}
+		lst column;
+		for (int k=0;k<dimension;++k)
+			column.append(Hook(e().dual()[k],sum));
+		return ex{column};
+	},symbols);
+	for (int j=0;j<dimension;++j)
+		for (int k=0;k<dimension;++k)
+			ric(k,j)=columns[j].op(k);
+	if (G) StoreCachedResult(key,ric);
 	return ric;
 }
 
 ExVector Connection::Torsion() const
 {
-	ExVector DTheta(frame.size());
+	ExVector DTheta;
 	try {
-		for (int i=0;i<frame.size();i++)
-		{
-			DTheta[i]=manifold->d(frame[i]);
+		DTheta=ParallelMap(frame.size(),[this] (int i) {
+			ex dtheta=manifold->d(frame[i]);
 			for (int j=0;j<frame.size();j++)
-				DTheta[i]+=operator()(i,j)*frame[j];
-		}
+				dtheta+=(*this)(i,j)*frame[j];
+			return dtheta;
+		},SymbolsIn(components));
 	}
 	catch (const Manifold::dException&)
 	{
@@ -119,15 +162,18 @@ matrix Connection::CurvatureForm() const
 	const int dimension=e().size();
 	matrix m(dimension,dimension);
 	try {	
-		for (int i=0;i<dimension;i++)
-			for (int j=0;j<dimension;j++) {
+		exvector entries=ParallelMap(dimension*dimension,[this,dimension] (int n) {
+			int i=n/dimension, j=n%dimension;
 			ex e=manifold->d(components[i][j]);
 			LOG_DEBUG(e);
 			for (int k=0;k<dimension;k++)
 				e+=components[i][k]*components[k][j];
 			LOG_DEBUG(e);
-			m(i,j)=e;
-			}
+			return e;
+		},SymbolsIn(components));
+		for (int i=0;i<dimension;i++)
+			for (int j=0;j<dimension;j++)
+				m(i,j)=entries[i*dimension+j];
 	}
 	catch (const Manifold::dException&)
 	{
@@ -140,7 +186,7 @@ void Connection::DeclareConditions(const lst& list_of_equations)
 {
 	for (int i=0;i<components.size();++i)
 		for (int j=0;j<components.size();++j)
-			components[i][j]=components[i][j].subs(list_of_equations).normal();	
+			components[i][j]=CachedNormal(components[i][j].subs(list_of_equations));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -203,8 +249,11 @@ ex internal::CovariantDerivative<Spinor>::Apply(const VectorField& X, const Spin
 {
 	ex res; 
 	for (int i=0;i<connection.e().size();++i)
-		for (int j=i+1;j<connection.e().size();++j)
-			res+=connection.g.CliffordDot(TrivialPairing<VectorField>(X,connection(i,j))*connection.e()[i]*connection.e()[j],psi);
+		for (int j=i+1;j<connection.e().size();++j) {
+			ex omega_ij=TrivialPairing<VectorField>(X,connection(i,j));
+			if (!omega_ij.is_zero())
+				res+=omega_ij*connection.g.CliffordDotByFrameVector(i+1,connection.g.CliffordDotByFrameVector(j+1,psi));
+		}
 	return -res/2;
 }
 
@@ -266,6 +315,21 @@ template<> LeviCivitaConnection<true>::LeviCivitaConnection(const Manifold* mani
 		 for (int i=0;i<dimension;++i)
 			 	for (int j=0;j<dimension;++j)
 				 		(*this)(i,j)=0;
+	auto G=CachingLieGroup(manifold);
+	string key;
+	if (G) {
+		key=G->CacheKey("LeviCivitaConnection",exvector(e().begin(),e().end()));
+		lst known;
+		CollectSymbols(lst(e().begin(),e().end()),known);
+		CollectSymbols(lst(manifold->e().begin(),manifold->e().end()),known);
+		ex cached;
+		if (LookupCachedResult(key,cached,known) && cached.nops()==dimension*dimension) {
+			for (int i=0;i<dimension;++i)
+			for (int j=0;j<dimension;++j)
+				(*this)(i,j)=cached.op(i*dimension+j);
+			return;
+		}
+	}
 	exvector de;
 	de.reserve(dimension);
 	for (int i=0;i<dimension;++i)
@@ -286,6 +350,13 @@ template<> LeviCivitaConnection<true>::LeviCivitaConnection(const Manifold* mani
 	for (int j=0;j<dimension;++j)
 	for (int k=j+1;k<dimension;++k)
 		(*this)(j,k)=-(*this)(k,j);
+	if (G) {
+		lst result;
+		for (int i=0;i<dimension;++i)
+		for (int j=0;j<dimension;++j)
+			result.append((*this)(i,j));
+		StoreCachedResult(key,result);
+	}
 }
 
 
@@ -314,13 +385,16 @@ matrix TorsionFreeConnection<false>::CurvatureForm() const
 	const int dimension=e().size();
 	assert(dimension>0);  
 	matrix m(dimension,dimension);
-	for (int i=0;i<dimension;i++)
-		for (int j=0;j<dimension;j++) {
+	exvector entries=ParallelMap(dimension*dimension,[this,dimension] (int n) {
+		int i=n/dimension, j=n%dimension;
 		ex e=d(components[i][j]);		
 		for (int k=0;k<dimension;k++)
 			e+=components[i][k]*components[k][j];
-		m(i,j)=e.expand();
-		}
+		return e.expand();
+	},SymbolsIn(components));
+	for (int i=0;i<dimension;i++)
+		for (int j=0;j<dimension;j++)
+			m(i,j)=entries[i*dimension+j];
 	return m;
 }
 
@@ -43,12 +43,14 @@ class ConnectionParameter : public Register<ConnectionParameter, Function>::Alge
 	friend class HasParameterList<ConnectionParameter>;
 	ConnectionParameter(const Name& name) : Register<ConnectionParameter, Function>::Algebraic(name) {}
 public:
+	ConnectionParameter() {}
 	static const char* static_class_name() {return "ConnectionParameter";}	
 };
 
 template<class Structure> class ManifoldWith;
 
 class Connection;
+class NumericCurvature;
 
 namespace internal {
 
@@ -215,6 +217,7 @@ protected:
 	vector<exvector> components; ///< The element components[i][j] represents omega(i,j), where i,j are zero-based indices
 private:
 	template<class Structure> friend class ManifoldWith;
+	friend class NumericCurvature;
 	Frame frame;	///< The "adapted" frame, i.e. the frame associated to this connection
 };
 
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "numericcurvature.h"
+
+namespace Wedge {
+
+NumericCurvature::NumericCurvature(const Connection& connection, const exvector& coordinates) : 
+	dimension(connection.e().size()), pairs(dimension*(dimension-1)/2)
+{
+	const int n=dimension;
+	matrix R=connection.CurvatureForm();
+	const ExVector& dual=connection.e().dual();
+	exvector components;	//Omega_{ij}(e_h,e_k) for h<k, the index of (i,j,h,k) being (i*n+j)*pairs+Pair(h,k)
+	for (int i=0;i<n;++i)
+	for (int j=0;j<n;++j)
+	for (int h=0;h<n;++h) {
+		ex hook=Hook(dual[h],R(i,j));
+		for (int k=h+1;k<n;++k)
+			components.push_back(Hook(dual[k],hook));
+	}
+	auto component=[this,&components,n] (int i, int j, int h, int k) -> ex {
+		if (h==k) return 0;
+		else if (h<k) return components[(i*n+j)*pairs+Pair(h,k)];
+		else return -components[(i*n+j)*pairs+Pair(k,h)];
+	};
+	exvector ric(n*n);
+	ex trace;
+	for (int k=0;k<n;++k)
+	for (int j=0;j<n;++j) {
+		for (int i=0;i<n;++i)
+			ric[k*n+j]+=component(i,j,i,k);
+		if (j==k) trace+=ric[k*n+j];
+	}
+	curvature=StraightLineProgram(coordinates,components);
+	ricci=StraightLineProgram(coordinates,ric);
+	scalar=StraightLineProgram(coordinates,{trace});
+}
+
+template<typename Scalar> vector<Scalar> NumericCurvature::CurvatureForm(const vector<Scalar>& points) const
+{
+	const int n=dimension;
+	vector<Scalar> values=curvature.Evaluate(points);
+	const int batch=Coordinates()? points.size()/Coordinates() : 1;
+	vector<Scalar> result(batch*n*n*n*n);
+	for (int p=0;p<batch;++p) {
+		const Scalar* in=&values[p*curvature.Outputs()];
+		Scalar* out=&result[p*n*n*n*n];
+		for (int ij=0;ij<n*n;++ij)
+		for (int h=0;h<n;++h)
+		for (int k=h+1;k<n;++k) {
+			Scalar x=in[ij*pairs+Pair(h,k)];
+			out[(ij*n+h)*n+k]=x;
+			out[(ij*n+k)*n+h]=-x;
+		}
+	}
+	return result;
+}
+
+template vector<double> NumericCurvature::CurvatureForm<double>(const vector<double>& points) const;
+template vector<complex<double>> NumericCurvature::CurvatureForm<complex<double>>(const vector<complex<double>>& points) const;
+
+}
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef NUMERICCURVATURE_H
+#define NUMERICCURVATURE_H
+
+/** @ingroup RiemannianGeometry */ 
+
+/** @{ 
+ * @file numericcurvature.h
+ * @brief Numerical evaluation of the curvature of a connection
+ */
+
+#include "wedge/connections/connection.h"
+#include "wedge/base/straightlineprogram.h"
+
+namespace Wedge {
+
+/** @brief The curvature of a connection, compiled for evaluation at many points
+ *
+ * The curvature form is computed symbolically once, and its components, the Ricci tensor and the scalar curvature are 
+ * compiled into straight-line programs (see StraightLineProgram) in the coordinates of the manifold. This is useful to 
+ * screen metrics numerically, e.g. on a ManifoldWithCoordinates, before attempting symbolic computations.
+ *
+ * Points are passed as arrays containing the coordinates of each point in turn; results are dense arrays, containing
+ * the values at each point in turn.
+ */
+class NumericCurvature {
+	int dimension;
+	int pairs;	//number of pairs h<k
+	StraightLineProgram curvature, ricci, scalar;
+	int Pair(int h, int k) const {return h*dimension-h*(h+1)/2+k-h-1;}	//index of the pair h<k
+public:
+/** @brief Compile the curvature of a connection
+ * @param connection A connection, whose connection form does not depend on parameters
+ * @param coordinates The functions the connection form depends on, e.g. ManifoldWithCoordinates::x()
+ * @exception InvalidArgument if the curvature depends on something other than the coordinates, e.g. on a parameter or a generic function
+ */
+	NumericCurvature(const Connection& connection, const exvector& coordinates);
+
+	int Dimension() const {return dimension;}
+	int Coordinates() const {return curvature.Variables();}
+
+/** @brief Evaluate the curvature form at a batch of points
+ * @param points The coordinates of the points, Coordinates() for each point
+ * @return The values \f$\Omega_{ij}(e_h,e_k)\f$ at each point, with \f$(i,j,h,k)\f$ in lexicographic order (n^4 values for each point)
+ *
+ * Scalar may be double or complex<double>.
+ * @sa Connection::CurvatureForm
+ */
+	template<typename Scalar> vector<Scalar> CurvatureForm(const vector<Scalar>& points) const;
+
+/** @brief Evaluate the Ricci tensor at a batch of points
+ * @param points The coordinates of the points, Coordinates() for each point
+ * @return The matrices representing the Ricci tensor at each point, as in Connection::RicciAsMatrix, with entries listed by rows
+ */
+	template<typename Scalar> vector<Scalar> RicciAsMatrix(const vector<Scalar>& points) const {return ricci.Evaluate(points);}
+
+/** @brief Evaluate the scalar curvature at a batch of points
+ * @param points The coordinates of the points, Coordinates() for each point
+ * @return The trace of the Ricci tensor at each point
+ *
+ * The trace is computed with respect to the frame of the connection, so this is the scalar curvature if the frame is orthonormal.
+ */
+	template<typename Scalar> vector<Scalar> ScalarCurvature(const vector<Scalar>& points) const {return scalar.Evaluate(points);}
+};
+
+} /** @} */
+#endif
@@ -6,18 +6,23 @@ namespace Wedge {
 class CovariantDerivativeSpinor: public IBilinearOperator<LinearOperator<VectorField>, Leibniz<Spinor,Function> > {
     const PseudoRiemannianStructureByOrthonormalFrame& g;
 	const PseudoLeviCivitaConnection& connection;
+    ExVector epsilon;   //the square norms of the frame vectors, so that (e^j)^\sharp=\epsilon_j e_j
     ex double_clifford(ZeroBased i, ZeroBased j, ex psi) const {
-        ex e_i=g.e().dual()[i];
-        ex e_jsharp=g.ScalarProduct().Sharp(g.e()[j]);
-        return g.CliffordDot(e_jsharp, g.CliffordDot(e_i,psi));
+        return epsilon[j]*g.CliffordDotByFrameVector(j+1, g.CliffordDotByFrameVector(i+1,psi));
     }
 public:
-	CovariantDerivativeSpinor(const PseudoRiemannianStructureByOrthonormalFrame& g, const PseudoLeviCivitaConnection& c) : g{g}, connection(c) {}
+	CovariantDerivativeSpinor(const PseudoRiemannianStructureByOrthonormalFrame& g, const PseudoLeviCivitaConnection& c) : g{g}, connection(c) {
+        for (int j=0;j<g.e().size();++j)
+            epsilon.push_back(TrivialPairing<VectorField>(g.ScalarProduct().Sharp(g.e()[j]),g.e()[j]));
+    }
 	ex Apply(const VectorField& X, const Spinor& psi) const {
         ex res; 
         for (int i=0;i<g.e().size();++i)
-            for (int j=i+1;j<g.e().size();++j) 
-                res+=TrivialPairing<VectorField>(X,connection(i,j))*double_clifford(i,j,psi);
+            for (int j=i+1;j<g.e().size();++j) {
+                ex omega_ij=TrivialPairing<VectorField>(X,connection(i,j));
+                if (!omega_ij.is_zero())
+                    res+=omega_ij*double_clifford(i,j,psi);
+            }
         return res/2;
     }
 	ex Apply(const VectorField& vfield, const Function& f) const {
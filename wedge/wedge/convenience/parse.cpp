@@ -20,6 +20,7 @@
 #include "wedge/base/wedgebase.h"
 #include "wedge/convenience/parse.h"
 #include "wedge/convenience/spiritgrammars.hpp"
+#include <cctype>
 
 /**
 	 @brief Convert a string into a list of forms  
@@ -34,7 +35,8 @@
  	*  - -1+2 -> \f$-e^1+e^2\f$
 	*  - 2*2 -> \f$2e^2\f$. The first two is interpreted as a constant because it is followed by a *.  
 	*  - 2/3*2 -> \f$\frac23e^2\f$. The first coefficient is interpreted as a fraction.  
-	*  - a + 1 -> \f$ e^{10}+e^1 \f$. a is hexadecimal 10 (the digits are 0, ..., 9, a, ..., f; 0 is not used). 
+	*  - a + 1 -> \f$ e^{10}+e^1 \f$. The digits are 1, ..., 9, a, ..., z, A, ..., Z, representing the indices 1, ..., 61. 
+	*  - {3,12,105} -> \f$e^3\wedge e^{12}\wedge e^{105}\f$. Indices between braces are written in decimal notation and separated by commas.
 	*  - [sqrt(2)]*45  -> \f$\sqrt2e^4\wedge e^5\f$. The expression between square brackets is interpreted as a ginac expression
 	*  - (1+2)^(3+2*4), or  (1+2)(3+2*4)  -> \f$(e^1+e^2)\wedge(e^3+2e^4)\f$
  	*  - 4*1+sqrt(2)*45  -> \f$4e^1+\sqrt2e^4\wedge e^5\f$
@@ -46,8 +48,8 @@
 	* If x is a form, (x) is a factor
 	* If x is either a GiNaC expression in square brackets or a positive rational number followed by a *, then x is a constant
 	* If x is a constant and y is a factor, x*y is a factor representing the product
-	* If x is a sequence of digits between 1 and min(15,frame.size()) not followed by a *, x is a factor representing a form, namely the product of the corresponding one-forms in the frame
- 	*  @note This notation will not work for frames of length greater than 15.
+	* If x is a sequence of digits representing indices between 1 and min(61,frame.size()) not followed by a *, x is a factor representing a form, namely the product of the corresponding one-forms in the frame
+	* If x is a comma-separated sequence of decimal integers between 1 and frame.size(), {x} is a factor representing the product of the corresponding one-forms in the frame
 
  * @remark The notation generalizes that of 
 	 * [S. Salamon :Complex structures on nilpotent Lie algebras. J. Pure Appl. Algebra 157 (2001), no. 2-3, 311--333]
@@ -86,38 +88,298 @@ const char* endOfString(const char* begin)
 }
 
 
+namespace internal {
+
+/** @brief Recursive descent parser for Salamon's notation, operating on lists of terms rather than ex's
+ *
+ * The grammar is the same as the one described in the documentation of ParseDifferentialForms; whitespace is ignored between tokens and between digits.
+ */
+class SalamonNotationReader {
+	typedef SalamonNotationParser::Term Term;
+	typedef SalamonNotationParser::Terms Terms;
+	SalamonNotationParser& parser;
+	const char* const begin;
+	const char* const end;
+	const char* pos;
+
+	[[noreturn]] void Fail() const {
+		throw ParseError(string{begin,end},__FILE__,__LINE__);
+	}
+	char Peek() {
+		while (pos!=end && isspace(static_cast<unsigned char>(*pos))) ++pos;
+		return pos==end? 0 : *pos;
+	}
+	bool Accept(char c) {
+		if (Peek()!=c) return false;
+		++pos;
+		return true;
+	}
+	void Expect(char c) {
+		if (!Accept(c)) Fail();
+	}
+	//read a nonnegative integer in decimal notation, without bounds on the number of digits
+	bool ReadInteger(numeric& n) {
+		if (!isdigit(static_cast<unsigned char>(Peek()))) return false;
+		const char* start=pos;
+		while (pos!=end && isdigit(static_cast<unsigned char>(*pos))) ++pos;
+		n=numeric(string{start,pos}.c_str());
+		return true;
+	}
+	//read an index in decimal notation, which must not exceed the length of the frame (or the range of int, if the parser is not bound to a frame)
+	int ReadIndex() {
+		Peek();		//skip whitespace
+		const char* start=pos;
+		numeric n;
+		if (!ReadInteger(n)) Fail();
+		if (n>parser.max_index) throw ParseError("index "+string{start,pos}+" out of range in "+string{begin,end},__FILE__,__LINE__);
+		return Index(n.to_int());
+	}
+	static bool StartsFactor(char c) {
+		return isalnum(static_cast<unsigned char>(c)) || c=='(' || c=='[' || c=='{';
+	}
+	int Index(int index) const {
+		if (index<=0 || index>parser.max_index) throw ParseError(index,__FILE__,__LINE__);
+		return index;
+	}
+	int IndexFromDigit(char digit) const {
+		if (digit>'0' && digit<='9') return Index(digit-'0');
+		else if (digit>='a' && digit<='z') return Index(digit-'a'+10);
+		else if (digit>='A' && digit<='Z') return Index(digit-'A'+10+26);
+		else throw ParseError(digit,__FILE__,__LINE__);
+	}
+
+	//the wedge product of the one-forms with the given indices, as a list of at most one term
+	static Terms Monomial(vector<int> indices) {
+		int sign=1;
+		for (int i=1;i<indices.size();++i)
+			for (int j=i;j>0 && indices[j-1]>=indices[j];--j) {
+				if (indices[j-1]==indices[j]) return {};
+				swap(indices[j-1],indices[j]);
+				sign=-sign;
+			}
+		return {Term{std::move(indices),sign}};
+	}
+	//merge two increasing sequences of indices, keeping track of the sign; return false if an index is repeated
+	static bool Merge(const vector<int>& a, const vector<int>& b, vector<int>& result, int& sign) {
+		result.clear();
+		result.reserve(a.size()+b.size());
+		auto i=a.begin(), j=b.begin();
+		while (i!=a.end() && j!=b.end()) {
+			if (*i==*j) return false;
+			else if (*i<*j) result.push_back(*i++);
+			else {
+				if ((a.end()-i)%2) sign=-sign;
+				result.push_back(*j++);
+			}
+		}
+		result.insert(result.end(),i,a.end());
+		result.insert(result.end(),j,b.end());
+		return true;
+	}
+	static Terms Wedge(const Terms& x, const Terms& y) {
+		Terms result;
+		result.reserve(x.size()*y.size());
+		vector<int> indices;
+		for (auto& s: x)
+		for (auto& t: y) {
+			int sign=1;
+			if (Merge(s.indices,t.indices,indices,sign))
+				result.push_back(Term{indices,sign*s.coefficient*t.coefficient});
+		}
+		return result;
+	}
+	static Terms Scale(Terms terms, ex coefficient) {
+		for (auto& term: terms) term.coefficient*=coefficient;
+		return terms;
+	}
+
+	ex BracketedExpression() {
+		const char* close=find(++pos,end,']');
+		if (close==end) Fail();
+		string expression{pos,close};
+		pos=close+1;
+		return parser.ParseExpression(expression);
+	}
+	Terms Factor() {
+		char c=Peek();
+		if (c=='(') {
+			++pos;
+			Terms result=Form();
+			Expect(')');
+			return result;
+		}
+		else if (c=='{') {
+			++pos;
+			vector<int> indices;
+			do indices.push_back(ReadIndex());
+			while (Accept(','));
+			Expect('}');
+			return Monomial(std::move(indices));
+		}
+		else if (c=='[') {
+			ex coefficient=BracketedExpression();
+			Expect('*');
+			return Scale(Factor(),coefficient);
+		}
+		else if (isdigit(static_cast<unsigned char>(c))) {
+			//an integer or a fraction followed by * is a constant; otherwise, the digits represent a simple form
+			const char* start=pos;
+			numeric numer, denom;
+			ReadInteger(numer);
+			ex coefficient=numer;
+			if (Accept('/')) {
+				if (!ReadInteger(denom) || denom.is_zero()) Fail();
+				coefficient=numer/denom;
+			}
+			if (Accept('*')) return Scale(Factor(),coefficient);
+			pos=start;
+		}
+		if (!isalnum(static_cast<unsigned char>(c))) Fail();
+		vector<int> indices;
+		while (isalnum(static_cast<unsigned char>(Peek()))) indices.push_back(IndexFromDigit(*pos++));
+		return Monomial(std::move(indices));
+	}
+	Terms WedgeProduct() {
+		Terms result=Factor();
+		while (true) {
+			const char* start=pos;
+			Accept('^');	//the wedge is optional
+			if (!StartsFactor(Peek())) {
+				pos=start;
+				return result;
+			}
+			result=Wedge(result,Factor());
+		}
+	}
+	Terms SignedTerm() {
+		bool negative=Accept('-');
+		char c=Peek();
+		Terms result;
+		if (c=='0') ++pos;
+		else if (StartsFactor(c)) result=WedgeProduct();
+		else Fail();
+		if (negative)
+			for (auto& term: result) term.coefficient=-term.coefficient;
+		return result;
+	}
+	Terms Form() {
+		Terms result=SignedTerm();
+		while (true) {
+			const char* start=pos;
+			Accept('+');
+			char c=Peek();
+			if (c!='-' && !StartsFactor(c)) {
+				pos=start;
+				return result;
+			}
+			Terms term=SignedTerm();
+			result.insert(result.end(),make_move_iterator(term.begin()),make_move_iterator(term.end()));
+		}
+	}
+	//sort the terms and collect those with the same indices
+	static Terms Normalize(Terms terms) {
+		sort(terms.begin(),terms.end(),[] (const Term& x, const Term& y) {return x.indices<y.indices;});
+		Terms result;
+		for (auto& term: terms)
+			if (!result.empty() && result.back().indices==term.indices) result.back().coefficient+=term.coefficient;
+			else result.push_back(std::move(term));
+		result.erase(remove_if(result.begin(),result.end(),[] (const Term& x) {return x.coefficient.is_zero();}),result.end());
+		return result;
+	}
+public:
+	SalamonNotationReader(SalamonNotationParser& parser, const char* begin, const char* end) : parser{parser}, begin{begin}, end{end}, pos{begin} {}
+	Terms ParseForm() {
+		Terms result=Normalize(Form());
+		if (Peek()) Fail();
+		return result;
+	}
+	void ParseForms(vector<Terms>& forms) {
+		do forms.push_back(Normalize(Form()));
+		while (Accept(','));
+		if (Peek()) Fail();
+	}
+};
+}
+
+SalamonNotationParser::SalamonNotationParser(ex symbols) : table{SymtabFromSymbols(symbols)} {}
+
+SalamonNotationParser::SalamonNotationParser(const exvector& frame, ex symbols) : frame{frame}, max_index{static_cast<int>(frame.size())}, table{SymtabFromSymbols(symbols)} {}
+
+ex SalamonNotationParser::ParseExpression(const string& expression) {
+	if (!ginac_parser) ginac_parser=make_unique<GiNaC::parser>(table,true);
+	return (*ginac_parser)(expression);
+}
+
+ex SalamonNotationParser::ParseForm(const char* to_parse) {
+	return ToForm(frame,internal::SalamonNotationReader{*this,to_parse,endOfString(to_parse)}.ParseForm());
+}
+
+ExVector SalamonNotationParser::ParseForms(const char* to_parse) {
+	vector<Terms> forms;
+	ParseTerms(to_parse,endOfString(to_parse),forms);
+	ExVector result;
+	result.reserve(forms.size());
+	for (auto& form: forms) result.push_back(ToForm(frame,form));
+	return result;
+}
+
+void SalamonNotationParser::ParseTerms(const char* begin, const char* end, vector<Terms>& forms) {
+	internal::SalamonNotationReader{*this,begin,end}.ParseForms(forms);
+}
+
+vector<SalamonNotationParser::Terms> SalamonNotationParser::ParseTerms(const char* to_parse) {
+	vector<Terms> forms;
+	ParseTerms(to_parse,endOfString(to_parse),forms);
+	return forms;
+}
+
+ex SalamonNotationParser::ToForm(const exvector& frame, const Terms& terms) {
+	exvector summands;
+	summands.reserve(terms.size());
+	exvector factors;
+	for (auto& term: terms) {
+		factors.clear();
+		for (int i: term.indices) {
+			if (i<=0 || i>frame.size()) throw ParseError(i,__FILE__,__LINE__);
+			factors.push_back(frame[i-1]);
+		}
+		summands.push_back(term.coefficient*ncmul(factors));
+	}
+	return dynallocate<add>(summands);
+}
+
 ex ParseDifferentialForm(const exvector& reference_coframe, const string& to_parse, ex symbols) 
 {
-	return DifferentialFormParser{reference_coframe,SymtabFromSymbols(symbols)}.ParseForm(to_parse.begin(),to_parse.end());
+	return SalamonNotationParser{reference_coframe,symbols}.ParseForm(to_parse);
 }
 ex ParseDifferentialForm(const exvector& reference_coframe, const char* to_parse, ex symbols) 
 {
-	return DifferentialFormParser{reference_coframe,SymtabFromSymbols(symbols)}.ParseForm(to_parse,endOfString(to_parse));
+	return SalamonNotationParser{reference_coframe,symbols}.ParseForm(to_parse);
 }
 ex ParseDifferentialForm(const exvector& reference_coframe, const string& to_parse) 
 {
-	return DifferentialFormParser{reference_coframe}.ParseForm(to_parse.begin(),to_parse.end());
+	return SalamonNotationParser{reference_coframe}.ParseForm(to_parse);
 }
 ex ParseDifferentialForm(const exvector& reference_coframe, const char* to_parse) 
 {
-	return DifferentialFormParser{reference_coframe}.ParseForm(to_parse,endOfString(to_parse));
+	return SalamonNotationParser{reference_coframe}.ParseForm(to_parse);
 }
 
 ExVector ParseDifferentialForms(const exvector& reference_coframe, const string& to_parse, ex symbols) 
 {
-	return DifferentialFormParser{reference_coframe,SymtabFromSymbols(symbols)}.ParseForms(to_parse.begin(),to_parse.end());
+	return SalamonNotationParser{reference_coframe,symbols}.ParseForms(to_parse);
 }
 ExVector ParseDifferentialForms(const exvector& reference_coframe, const char* to_parse, ex symbols) 
 {
-	return DifferentialFormParser{reference_coframe,SymtabFromSymbols(symbols)}.ParseForms(to_parse,endOfString(to_parse));
+	return SalamonNotationParser{reference_coframe,symbols}.ParseForms(to_parse);
 }
 ExVector ParseDifferentialForms(const exvector& reference_coframe, const string& to_parse) 
 {
-	return DifferentialFormParser{reference_coframe}.ParseForms(to_parse.begin(),to_parse.end());
+	return SalamonNotationParser{reference_coframe}.ParseForms(to_parse);
 }
 ExVector ParseDifferentialForms(const exvector& reference_coframe, const char* to_parse) 
 {
-	return DifferentialFormParser{reference_coframe}.ParseForms(to_parse,endOfString(to_parse));
+	return SalamonNotationParser{reference_coframe}.ParseForms(to_parse);
 }
 
 
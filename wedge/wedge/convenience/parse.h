@@ -46,6 +46,7 @@ public:
  	*  - 4*1+sqrt(2)*45  -> \f$4e^1+\sqrt2e^4\wedge e^5\f$
  	* 
  	*  @note Forms between e^10 and e^35 can be defined using the letters a-z; forms between e^36 and e^61 with the letters A-Z.
+ 	*  Indices of any size can be written in decimal notation between braces, e.g. {1,12,105} represents \f$e^1\wedge e^{12}\wedge e^{105}\f$.
 	 */
 	ExVector ParseDifferentialForms(const exvector& frame, const char* to_parse);
 	/** @overload
@@ -81,5 +82,72 @@ public:
 	/** @overload
 	 */	
 	ex ParseCocoaExpression(const exvector& symbols, const char* to_parse);
+
+namespace internal {
+	class SalamonNotationReader;
+}
+
+/** @brief Reusable parser for differential forms in Salamon's notation
+ *
+ * A SalamonNotationParser is bound once to a reference coframe and a list of symbols, and can be used to parse any number of strings.
+ * Forms are parsed into lists of terms, each consisting of an increasing sequence of indices and a coefficient; an ex is only
+ * constructed when the terms are converted into a form. 
+ *
+ * @sa ParseDifferentialForms for a description of the notation
+ */
+class SalamonNotationParser {
+public:
+	/** @brief A term in a differential form, i.e. a coefficient times the wedge product of the frame elements with the given (one-based, increasing) indices
+	 */
+	struct Term {
+		vector<int> indices;
+		ex coefficient;
+	};
+	typedef vector<Term> Terms;	///< A differential form, represented as a list of terms with distinct indices
+
+	/** @brief Construct a parser not bound to any frame; only the methods returning terms can be used
+	 * @param symbols A symbol or lst of symbols that may appear in expressions between square brackets
+	 */
+	explicit SalamonNotationParser(ex symbols=lst{});
+	/** @brief Construct a parser bound to a frame
+	 * @param frame A reference frame, in the guise of a vector of one-forms 
+	 * @param symbols A symbol or lst of symbols that may appear in expressions between square brackets
+	 */
+	SalamonNotationParser(const exvector& frame, ex symbols=lst{});
+
+	/** @brief Parse a single form
+	 * @throws ParseError if the string is not a valid form in Salamon's notation, or it refers to an element not in the frame
+	 */
+	ex ParseForm(const char* to_parse);
+	ex ParseForm(const string& to_parse) {return ParseForm(to_parse.c_str());}	///< @overload
+	/** @brief Parse a comma-separated list of forms
+	 * @throws ParseError if the string is not a valid list of forms in Salamon's notation, or it refers to an element not in the frame
+	 */
+	ExVector ParseForms(const char* to_parse);
+	ExVector ParseForms(const string& to_parse) {return ParseForms(to_parse.c_str());}	///< @overload
+
+	/** @brief Parse a comma-separated list of forms into terms
+	 * @param begin,end The range of characters to parse
+	 * @param forms A vector to which the parsed forms are appended
+	 */
+	void ParseTerms(const char* begin, const char* end, vector<Terms>& forms);
+	/** @overload
+	 */
+	vector<Terms> ParseTerms(const char* to_parse);
+
+	/** @brief Convert a list of terms into a form
+	 * @param frame A reference frame, in the guise of a vector of one-forms 
+	 * @param terms The terms, as returned by ParseTerms
+	 * @throws ParseError if an index exceeds the length of the frame
+	 */
+	static ex ToForm(const exvector& frame, const Terms& terms);
+private:
+	exvector frame;
+	int max_index=INT_MAX;
+	GiNaC::symtab table;
+	unique_ptr<GiNaC::parser> ginac_parser;	//created on first use, since most strings contain no expression in square brackets
+	ex ParseExpression(const string& expression);
+	friend class internal::SalamonNotationReader;
+};
 }
 #endif
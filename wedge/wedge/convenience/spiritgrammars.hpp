@@ -41,34 +41,6 @@ template<typename TypeToDisplay> class DisplayType;
 @throws std::invalid_argument if the string contains a symbol that does not appear in the symbols list
 */
 
-class FormParser {
-	static const exvector* reference_coframe_;
-	ex OneFormFromIndex(int index) const {
-		if (index<=0 || index>reference_coframe_->size()) throw ParseError(index,__FILE__,__LINE__);
-		return reference_coframe_->at(index-1);
-	}
-	ex OneFormFromDigit(char digit) const {
-		if (digit>'0' && digit<='9') return OneFormFromIndex(digit-'0');
-		else if (digit>='a' && digit<='z') return OneFormFromIndex(digit-'a'+10);
-		else if (digit>='A' && digit<='Z') return OneFormFromIndex(digit-'A'+10+26);
-		else throw ParseError(digit,__FILE__,__LINE__);
-	}
-	template<typename Container>
-	ex Parse(Container digit_sequence) const {
-		auto i=digit_sequence.begin();
-		ex result=OneFormFromDigit(*i);
-		while (++i!=digit_sequence.end()) result*=OneFormFromDigit(*i);
-		return result;
-	}
-public:
-	static void SetReferenceCoframe(const exvector* reference_coframe) noexcept {
-		 reference_coframe_=reference_coframe;
-	}
-	template<typename Context> void operator() (const Context& ctx) const {
-		x3::_val(ctx)=Parse(x3::_attr(ctx));
-	}
-};
-
 class ExpressionParser {
 	static unique_ptr<GiNaC::parser> ginac_parser;
 	static bool is_symtab_trivial;
@@ -102,99 +74,11 @@ public:
 };
 
 
-const exvector* FormParser::reference_coframe_=nullptr;
 unique_ptr<GiNaC::parser> ExpressionParser:: ginac_parser = make_unique<GiNaC::parser>(symtab(),true);
 const exvector* CocoaVariableParser::variables_=nullptr;
 bool ExpressionParser::is_symtab_trivial=true;
 
 
-namespace DifferentialFormGrammar {
-	using namespace SemanticActions;
-	ExpressionParser expression_parser;
-	FormParser form_parser;
-
-	x3::rule<class integer_id, unsigned int>	//declare an incomplete type as template argument, used by X3 framework as an ID; notice that this will create problems if a class with that name is defined elsewhere
-	        integer = "Integer";
-	x3::rule<class ginac_expression_id, ex>
-	        ginac_expression = "GinacExpression";
-	x3::rule<class constant_id, ex>
-	        constant = "Constant";
-	x3::rule<class simple_form_id, ex>
-	        simple_form = "SimpleForm";
-	x3::rule<class factor_id, ex>
-	        factor = "Factor";
-	x3::rule<class product_id, ex>
-	        product = "Product";
-	x3::rule<class quotient_id, ex>
-	        quotient = "Quotient";
-	x3::rule<class wedge_product_id, ex>
-	        wedge_product = "WedgeProduct";
-	x3::rule<class zero, ex>
-	        zero = "Zero";
-	x3::rule<class term_id, ex>
-	        term = "Term";
-	x3::rule<class negative_term_id, ex>
-	        negative_term = "NegativeTerm";
-	x3::rule<class signed_term_id, ex>
-	        signed_term = "SignedTerm";
-	x3::rule<class form_id, ex>
-	        form = "Form";
-	x3::rule<class forms_id, ExVector>
-	        forms = "Forms";
-
-	auto integer_def = x3::uint_;
-	auto ginac_expression_def='[' >> ((*(ascii::char_ - ']'))[expression_parser]) >> ']';
-	auto quotient_def =  (integer >> '/'> integer)[read_quotient];
-	auto constant_def = ginac_expression | quotient | integer;
-	auto simple_form_def=(+x3::alnum)[form_parser];
-	auto product_def = (constant >>  '*' > factor)[read_product];
-	auto factor_def = product |  simple_form |  ('('> form > ')');
-	auto wedge_product_def=	(factor % -x3::lit('^'))[read_wedge_product];	//the wedge is optional
-	auto zero_def=x3::lit('0') [read_zero];
-	auto term_def = zero_def | wedge_product_def;
-	auto negative_term_def = ( '-' > term )[read_opposite];
-	auto signed_term_def = negative_term | term;
-	auto form_def =	(signed_term % -x3::lit('+'))[read_sum];
-	auto forms_def = (form % ',') > x3::eoi;
-
-	BOOST_SPIRIT_DEFINE(integer,ginac_expression,constant,simple_form,product, factor,term,signed_term,form,forms,zero,wedge_product,negative_term,quotient);	
-}
-
-
-
-class DifferentialFormParser {
-public:
-	DifferentialFormParser(const exvector& reference_coframe)
-	{
-		FormParser::SetReferenceCoframe(&reference_coframe);
-	}
-	DifferentialFormParser(const exvector& reference_coframe, const symtab& symbol_table)
-	{
-		ExpressionParser::SetSymbolTable(symbol_table);
-		FormParser::SetReferenceCoframe(&reference_coframe);
-	}
-	~DifferentialFormParser() noexcept {
-		ExpressionParser::ResetSymbolTable();
-		FormParser::SetReferenceCoframe(nullptr);
-	}
-
-	template<typename Iterator> ex ParseForm(Iterator begin, Iterator end)
-	{
-		ex result;
-		if (!x3::phrase_parse(begin,end,DifferentialFormGrammar::form,ascii::space,result))			
-			throw ParseError("Error parsing differential form",__FILE__,__LINE__);
-		return result;
-	}
-	template<typename Iterator> ExVector ParseForms(Iterator begin, Iterator end)
-	{
-		ExVector result;
-		if (!x3::phrase_parse(begin,end,DifferentialFormGrammar::forms,ascii::space,result))			
-			throw ParseError("Error parsing differential forms",__FILE__,__LINE__);
-		return result;
-	}
-};
-
-
 namespace CocoaParserGrammar {
 	using namespace SemanticActions;
 	CocoaVariableParser cocoa_variable_parser;
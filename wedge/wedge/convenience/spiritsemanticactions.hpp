@@ -33,25 +33,13 @@ namespace Wedge {
 
 
 namespace SemanticActions {
-	static auto read_zero=[](auto& ctx) {x3::_val(ctx)=0;};
 	static auto read_opposite=[](auto& ctx) {x3::_val(ctx)=-x3::_attr(ctx);};
 
-	static auto read_product=[](auto& ctx) {
-		ex op1 = fusion::at_c<0>(x3::_attr(ctx));
-		ex op2 = fusion::at_c<1>(x3::_attr(ctx));
-		x3::_val(ctx)=op1*op2;
-	};
 	static auto read_mul=[](auto& ctx) {
 		static_assert(is_convertible<decltype(x3::_attr(ctx)),exvector>::value,"synthesized attribute should be exvector");
 		auto& factors = x3::_attr(ctx);
 		x3::_val(ctx)= mul(factors);
 	};
-	static auto read_wedge_product=[](auto& ctx) {
-		static_assert(is_convertible<decltype(x3::_attr(ctx)),exvector>::value,"synthesized attribute should be exvector");
-		//DisplayType<decltype(x3::_attr(ctx))> type_display;
-		exvector factors (x3::_attr(ctx));
-		x3::_val(ctx)=ncmul(factors);
-	};
 	static auto read_quotient =[](auto& ctx) {
 		ex numer = fusion::at_c<0>(x3::_attr(ctx));
 		ex denom = fusion::at_c<1>(x3::_attr(ctx));
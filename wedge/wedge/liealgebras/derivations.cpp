@@ -20,6 +20,7 @@
 
 #include "derivations.h"
 #include "wedge/representations/repgl.h"
+#include "wedge/linearalgebra/sparselinearsystem.h"
 
 namespace Wedge {
 ex Xbracket(const LieGroup& G, const GLRepresentation<VectorField>& V, ex A, ex X, ex Y) {
@@ -46,8 +47,68 @@ lst equations_such_that_linear_map_is_derivation(const LieGroup& G, const GL& gl
 }
 	
 
+namespace internal {
+//computes c[i][j][k] such that [e_i,e_j]=\sum_k c_{ij}^k e_k; returns false if the structure constants are not all rational
+bool RationalStructureConstants(const LieGroup& G, vector<vector<vector<numeric>>>& c) {
+	int n=G.Dimension();
+	c.assign(n,vector<vector<numeric>>(n,vector<numeric>(n,0)));
+	for (int i=0;i<n;++i)
+	for (int j=i+1;j<n;++j) {
+		ExVector comps=G.e().Components(G.LieBracket(G.e()[i],G.e()[j]));
+		for (int k=0;k<n;++k) {
+			if (!SparseLinearSystem::IsCoefficient(comps[k])) return false;
+			c[i][j][k]=ex_to<numeric>(comps[k]);
+			c[j][i][k]=-c[i][j][k];
+		}
+	}
+	return true;
+}
+
+//assembles the system D[e_j,e_k]=[De_j,e_k]+[e_j,De_k] in the unknowns a_{ij}, where De_j=\sum_i a_{ij}e_i; returns false if the structure constants are not rational
+bool DerivationsFromStructureConstants(const LieGroup& G,const GL& Gl, const VectorSpace<DifferentialForm>& gl, exvector& solutions) {
+	int n=G.Dimension();
+	if (Gl.n()!=n) return false;
+	vector<vector<vector<numeric>>> c;
+	if (!RationalStructureConstants(G,c)) return false;
+	map<ex,int,ex_is_less> position;
+	for (int p=0;p<gl.Dimension();++p) position.emplace(gl.e()[p],p);
+	vector<vector<int>> a(n,vector<int>(n));	//a[i][j] is the index of the unknown a_{ij}
+	for (int i=0;i<n;++i)
+	for (int j=0;j<n;++j) {
+		auto p=position.find(Gl.A(i+1,j+1));
+		if (p==position.end()) return false;
+		a[i][j]=p->second;
+	}
+	SparseLinearSystem system(gl.Dimension());
+	for (int j=0;j<n;++j)
+	for (int k=j+1;k<n;++k)
+	for (int m=0;m<n;++m) {
+		SparseLinearSystem::Row row;
+		auto add=[&row] (int unknown, const numeric& coefficient) {
+			if (!coefficient.is_zero()) row[unknown]+=coefficient;
+		};
+		for (int l=0;l<n;++l) add(a[m][l],c[j][k][l]);
+		for (int i=0;i<n;++i) {
+			add(a[i][j],-c[i][k][m]);
+			add(a[i][k],-c[j][i][m]);
+		}
+		system.AddEquation(std::move(row));
+	}
+	for (auto& solution: system.Solutions()) {
+		ex element;
+		for (int p=0;p<solution.size();++p)
+			element+=solution[p]*gl.e()[p];
+		solutions.push_back(element);
+	}
+	return true;
+}
+}
+
 VectorSpace<DifferentialForm> derivations(const LieGroup& G,const GL& Gl)  {
 		auto gl=Gl.pForms(1);
+		exvector solutions;
+		if (internal::DerivationsFromStructureConstants(G,Gl,gl,solutions))
+			return {solutions.begin(),solutions.end()};
 		auto generic_matrix =gl.GenericElement();				
 		auto eqns=equations_such_that_linear_map_is_derivation(G,Gl,generic_matrix);
 		lst sol;		
@@ -55,4 +116,4 @@ VectorSpace<DifferentialForm> derivations(const LieGroup& G,const GL& Gl)  {
 		return {sol.begin(),sol.end()};
 }
 
-}
\ No newline at end of file
+}
@@ -18,8 +18,11 @@
  *  
  *******************************************************************************/
 #include "wedge/liealgebras/liegroup.h"
+#include "wedge/linearalgebra/bilinearform.h"
 #include "wedge/convenience/parse.h"
 #include "wedge/convenience/canonicalprint.h"
+#include "wedge/base/parallel.h"
+#include "wedge/base/resultcache.h"
 
 namespace Wedge {
 
@@ -34,12 +37,46 @@ ostream& LieGroup::canonical_print(ostream& os) const {
 	return os<<")";
 }
 
+string LieGroup::CacheKey(const string& operation, const exvector& input) const
+{
+	ostringstream key;
+	canonical_print(key)<<":"<<operation;
+	for (auto& x: input) {
+		key<<":";
+		Wedge::canonical_print(key,x);
+	}
+	return key.str();
+}
+
+const LieGroup::BracketTable* LieGroup::StructureConstantsTable() const
+{
+	if (!internal::FrameMonomials::Supports(e())) return nullptr;
+	const exvector& dei=dFrame();
+	if (dei.size()==table_d.size() && equal(dei.begin(),dei.end(),table_d.begin(),[] (const ex& x, const ex& y) {return x.is_equal(y);}))
+		return &table;
+	internal::FrameMonomials monomials(e());
+	BracketTable new_table;
+	for (int k=0;k<dei.size();++k) {
+		internal::FrameMonomials::Terms terms;
+		if (!monomials.Decompose(dei[k],terms)) return nullptr;
+		for (auto& term: terms) {
+			if (term.first.Size()!=2) return nullptr;
+			ex c=-term.second.expand();	//de^k=-\sum_{i<j} c_{ij}^k e^{ij}
+			if (!c.is_zero()) new_table[term.first].emplace_back(k,c);
+		}
+	}
+	table=std::move(new_table);
+	table_d=dei;
+	return &table;
+}
+
 
 namespace internal {
 
 struct NestLevel {
 	int round_bracket_nesting=0;
 	int square_bracket_nesting=0;
+	int curly_bracket_nesting=0;
 public:
 	void parse(char c) {
 		switch (c) {
@@ -47,10 +84,12 @@ public:
 			case ')': --round_bracket_nesting;break;
 			case '[': ++square_bracket_nesting;break;
 			case ']': --square_bracket_nesting;break;
+			case '{': ++curly_bracket_nesting;break;
+			case '}': --curly_bracket_nesting;break;
 			default: break;
 		}
 	}
-	int level() const {return round_bracket_nesting+square_bracket_nesting;}
+	int level() const {return round_bracket_nesting+square_bracket_nesting+curly_bracket_nesting;}
 };
 
 int GetFrameLength(string structureConstants) {
@@ -65,17 +104,41 @@ int GetFrameLength(string structureConstants) {
 
 }
 
-AbstractLieGroup<false>::AbstractLieGroup(const char* structure_constants)  : ConcreteManifold(internal::GetFrameLength(structure_constants))
+AbstractLieGroup<false>::AbstractLieGroup(const char* structure_constants) : AbstractLieGroup{SalamonNotationParser{}.ParseTerms(structure_constants)}
 {
-	exvector forms=ParseDifferentialForms(e(),structure_constants);
-	assert(forms.size()==Dimension());
-	exvector::const_iterator i=forms.begin(),j=e().begin();
-	while (i!=forms.end())
-	{		
-		LOG_DEBUG(*j);
-		LOG_DEBUG(*i);
-		Declare_d(*j++,*i++);				
+}
+
+AbstractLieGroup<false>::AbstractLieGroup(const vector<SalamonNotationParser::Terms>& structure_constants) : ConcreteManifold(structure_constants.size())
+{
+	exvector::const_iterator j=e().begin();
+	for (auto& terms : structure_constants)
+		Declare_d(*j++,SalamonNotationParser::ToForm(e(),terms));
+}
+
+bool internal::LieGroupReader::Next()
+{
+	while (getline(is,line)) {
+		auto begin=line.find_first_not_of(" \t\r");
+		if (begin==string::npos || line[begin]=='#') continue;
+		structure_constants.clear();
+		try {
+			parser.ParseTerms(line.data()+begin,line.data()+line.size(),structure_constants);
+		}
+		catch (const ParseError&) {
+			throw ParseError(line,__FILE__,__LINE__);
+		}
+		return true;
 	}
+	return false;
+}
+
+vector<unique_ptr<AbstractLieGroup<false>>> LoadLieGroups(istream& is)
+{
+	vector<unique_ptr<AbstractLieGroup<false>>> result;
+	internal::LieGroupReader reader{is};
+	while (reader.Next())
+		result.push_back(make_unique<AbstractLieGroup<false>>(reader.StructureConstants()));
+	return result;
 }
 
 list<ex> collate() {
@@ -101,11 +164,21 @@ Subspace<DifferentialForm> LieGroupHasParameters<false>::ClosedForms(int degree)
 {
 	if (degree<=0 || degree>Dimension()) throw OutOfRange(__FILE__,__LINE__,degree);
 	VectorSpace<DifferentialForm> forms=pForms(degree);
+	string key;
+	ex cached;
+	if (!ResultCacheDirectory().empty()) {
+		key=CacheKey("ClosedForms("+ToString(degree)+")");
+		if (LookupCachedResult(key,cached,lst(e().begin(),e().end()))) {
+			exvector basis(cached.begin(),cached.end());
+			return forms.Subspace(basis.begin(),basis.end());
+		}
+	}
 	list<ex> equations;
 	GetCoefficients<DifferentialForm> (equations,d(forms.GenericElement()));
 	exvector sol;
 	forms.GetSolutions(sol,equations.begin(),equations.end());
-	return forms.SubspaceFromEquations(equations.begin(),equations.end());
+	if (!key.empty()) StoreCachedResult(key,lst(sol.begin(),sol.end()));
+	return forms.Subspace(sol.begin(),sol.end());
 }
 VectorSpace<DifferentialForm> LieGroupHasParameters<false>::ExactForms(int degree) const
 {	 
@@ -130,22 +203,50 @@ bool LieGroupHasParameters<false>::IsUnimodular() const
 vector<int> LieGroupHasParameters<false>::BettiNumbers() const
 {
 	vector<int> v(Dimension()+1);
+	string key;
+	ex cached;
+	if (!ResultCacheDirectory().empty()) {
+		key=CacheKey("BettiNumbers");
+		if (LookupCachedResult(key,cached) && cached.nops()==v.size()) {
+			for (int i=0;i<=Dimension();i++)
+				v[i]=ex_to<numeric>(cached.op(i)).to_int();
+			return v;
+		}
+	}
 	v[0]=1;
 	for (int i=1;i<=Dimension();i++)
 		v[i]=ClosedForms(i).Dimension()-ExactForms(i).Dimension();
+	if (!key.empty()) {
+		lst betti;
+		for (int b: v) betti.append(b);
+		StoreCachedResult(key,betti);
+	}
 	return v;
 }
 
 matrix LieGroup::KillingForm() const
 {
-	matrix R(Dimension(),Dimension());
-	for (int i=0;i<Dimension();++i)
-	for (int j=i;j<Dimension();++j)
-	{
-		for (int k=0;k<Dimension();++k)
-			R(i,j)+=TrivialPairing<VectorField>(e()[k],LieBracket(e()[i],LieBracket(e()[j],e()[k])));
-		R(j,i)=R(i,j);
-	}
+	const int n=Dimension();
+	matrix R(n,n);
+	lst symbols;
+	for (int k=0;k<n;++k)
+		CollectSymbols(dFrame()[k],symbols);
+	FrameBrackets();	//compute the table of brackets before work is distributed
+	//entries on and above the diagonal
+	vector<pair<int,int>> pairs;
+	pairs.reserve(n*(n+1)/2);
+	for (int i=0;i<n;++i)
+	for (int j=i;j<n;++j)
+		pairs.emplace_back(i,j);
+	exvector entries=ParallelMap(pairs.size(),[this,n,&pairs] (int m) {
+		int i=pairs[m].first, j=pairs[m].second;
+		ex Rij;
+		for (int k=0;k<n;++k)
+			Rij+=TrivialPairing<VectorField>(e()[k],LieBracket(e()[i],LieBracket(e()[j],e()[k])));
+		return Rij;
+	},symbols);
+	for (int m=0;m<pairs.size();++m)
+		R(pairs[m].first,pairs[m].second)=R(pairs[m].second,pairs[m].first)=entries[m];
 	return R;
 }
 
@@ -157,7 +258,7 @@ ex LieGroup::ThreeForm() const
 	for (int j=i+1;j<=Dimension();++j)
 	for (int k=j+1;k<=Dimension();++k)
 	for (int l=1;l<=Dimension();++l)
-		res+=-Killing(l-1,k-1)*Hook(e(i)*e(j),d(e(l)))*e(i)*e(j)*e(k);
+		res+=-Killing(l-1,k-1)*Hook(e(i)*e(j),dFrame()[l-1])*e(i)*e(j)*e(k);
 	return res;
 }
 
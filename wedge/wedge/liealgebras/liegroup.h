@@ -23,6 +23,7 @@
 #include "wedge/convenience/parse.h"
 #include "wedge/linearalgebra/vectorspace.h"
 #include "wedge/linearalgebra/lambda.h"
+#include "wedge/linearalgebra/bilinearform.h"
 #include "wedge/base/parameters.h"
 #include "wedge/polynomialalgebra/polybasis.h"
 
@@ -60,7 +61,7 @@ public:
 	{
 		ExVector dei(Dimension());
 		for (int i=1;i<=Dimension();i++)			
-			dei(i)=NormalForm<DifferentialForm>(d(e(i)));
+			dei(i)=NormalForm<DifferentialForm>(dFrame()[i-1]);
 		return dei;	
 	}		
 /** @brief Returns the Killing form of the Lie group
@@ -79,6 +80,25 @@ public:
 	 */
 
 	ostream& canonical_print(ostream& os) const;
+
+	/** @brief Return a key identifying a computation on this Lie group in the result cache (see resultcache.h)
+	 * @param operation The name of the operation, including any non-symbolic arguments
+	 * @param input Any further input of the computation, which is included in canonical form
+	 */
+	string CacheKey(const string& operation, const exvector& input=exvector()) const;
+
+	typedef map<internal::FrameMask,vector<pair<int,ex>>> BracketTable;	///< Maps a bitmask representing zero-based indices \f$i<j\f$ to the pairs \f$(k,c_{ij}^k)\f$ with \f$c_{ij}^k\neq0\f$
+
+	/** @brief Return the structure constants as a sparse table
+	 * @return The table of the constants \f$c_{ij}^k\f$ such that \f$[e_i,e_j]=\sum_k c_{ij}^k e_k\f$, or a null pointer if the frame
+	 * does not consist of distinct simple one-forms
+	 *
+	 * The table is computed from the forms \f$de^k\f$, and only recomputed when these change.
+	 */
+	const BracketTable* StructureConstantsTable() const;
+private:
+	mutable exvector table_d;	//the forms de^k from which table was computed
+	mutable BracketTable table;
 };
 
 /** @brief Overloaded output operator
@@ -94,7 +114,7 @@ template<class charT, class traits> std::basic_ostream<charT,traits>& operator<<
 		{
 			ex XiXj;
 			for (int k=1;k<=G.Dimension();k++)
-				XiXj-=TrivialPairing<DifferentialForm>(G.d(G.e(k)),G.e(i)*G.e(j))*G.e().dual()(k);
+				XiXj-=TrivialPairing<DifferentialForm>(G.dFrame()[k-1],G.e(i)*G.e(j))*G.e().dual()(k);
 			if (!XiXj.is_zero()) os<<"["<<G.e(i)<<","<<G.e(j)<<"]="<<XiXj<<endl;
 		}
 	return os;
@@ -248,8 +268,68 @@ public:
   */
 	AbstractLieGroup(const char* structure_constants);
 	AbstractLieGroup(const string& structure_constants): AbstractLieGroup{structure_constants.c_str()} {}
+  /** @brief Define a Lie group by structure constants in the form returned by SalamonNotationParser::ParseTerms
+   *  @param structure_constants A vector whose i-th element represents \f$de^{i+1}\f$
+  */
+	AbstractLieGroup(const vector<SalamonNotationParser::Terms>& structure_constants);
 };
 
+namespace internal {
+/** @brief Helper class to read a sequence of Lie groups from a stream, reusing the same parser for each line
+ */
+class LieGroupReader {
+	istream& is;
+	SalamonNotationParser parser;
+	string line;
+	vector<SalamonNotationParser::Terms> structure_constants;
+public:
+	LieGroupReader(istream& is) : is{is} {}
+	/** @brief Read the next line containing structure constants, skipping empty lines and lines beginning with #
+	 * @return false if the end of the stream has been reached
+	 * @throws ParseError if the line cannot be parsed
+	 */
+	bool Next();
+	const vector<SalamonNotationParser::Terms>& StructureConstants() const {return structure_constants;}
+};
+}
+
+/** @brief Read a list of Lie groups from a stream, one per line, calling a function on each
+ *  @param is A stream containing structure constants in Salamon's notation, such as "0,0,12,13"; empty lines and lines beginning with # are ignored
+ *  @param f A function object, invoked as f(G) on each AbstractLieGroup<false> G as soon as it is read
+ *  @return The number of Lie groups read
+ *  @throws ParseError if a line cannot be parsed, or it refers to an index greater than the number of forms in the line
+ *
+ *  The dimension of each group is the number of comma-separated forms in its line; indices greater than 61 can be written between braces, as in {1,12,105} (see ParseDifferentialForms).
+ *  The same parser is used for all lines, and each group is destroyed when f returns, so that long classification lists can be processed 
+ *  without keeping them in memory. Lines are read until the end of the stream; the groups read before a ParseError has been thrown have already been passed to f.
+ *
+ *  Example:
+ * @code
+ * ifstream list("nilpotent7.txt");
+ * ForEachLieGroup(list,[] (const AbstractLieGroup<>& G) {
+ * 	if (G.IsUnimodular()) cout<<G<<endl;
+ * });
+ * @endcode
+ */
+template<typename Function> int ForEachLieGroup(istream& is, Function&& f) {
+	internal::LieGroupReader reader{is};
+	int count=0;
+	while (reader.Next()) {
+		AbstractLieGroup<false> G{reader.StructureConstants()};
+		f(G);
+		++count;
+	}
+	return count;
+}
+
+/** @brief Read a list of Lie groups from a stream, one per line
+ *  @param is A stream containing structure constants in Salamon's notation, such as "0,0,12,13"; empty lines and lines beginning with # are ignored
+ *  @return A vector containing the Lie groups, in the order in which they appear
+ *  @throws ParseError if a line cannot be parsed
+ *  @sa ForEachLieGroup
+ */
+vector<unique_ptr<AbstractLieGroup<false>>> LoadLieGroups(istream& is);
+
 
 template<> 
 class AbstractLieGroup<true> : public LieGroupFamily {	
@@ -18,7 +18,69 @@
  *  
  *******************************************************************************/
 #include "wedge/liealgebras/liesubgroup.h"
+#include "wedge/linearalgebra/bilinearform.h"
 namespace Wedge {
+namespace internal {
+bool BracketsFromStructureConstants(const LieGroup& G, const exvector& subalgebra, vector<exvector>& brackets)
+{
+	auto table=G.StructureConstantsTable();
+	if (!table) return false;
+	FrameMonomials monomials(G.e());
+	vector<FrameMonomials::Terms> components(subalgebra.size());
+	for (int i=0;i<subalgebra.size();++i) {
+		if (!monomials.Decompose(subalgebra[i],components[i])) return false;
+		for (auto& term : components[i])
+			if (term.first.Size()!=1) return false;
+	}
+	brackets.assign(subalgebra.size(),exvector(subalgebra.size()));
+	for (int i=0;i<subalgebra.size();++i)
+	for (int j=i+1;j<subalgebra.size();++j) {
+		exvector bracket(G.Dimension());
+		for (auto& x: components[i])
+		for (auto& y: components[j]) {
+			auto entry=table->find(x.first|y.first);
+			if (x.first==y.first || entry==table->end()) continue;
+			ex coefficient=x.first<y.first? x.second*y.second : -x.second*y.second;
+			for (auto& c: entry->second) bracket[c.first]+=coefficient*c.second;
+		}
+		for (int k=0;k<G.Dimension();++k)
+			brackets[i][j]+=bracket[k].expand()*G.e()[k];
+	}
+	return true;
+}
+
+bool ProjectedDifferentialsFromStructureConstants(const LieGroup& G, const Subspace<DifferentialOneForm>& h, const exvector& forms, exvector& d)
+{
+	auto table=G.StructureConstantsTable();
+	if (!table) return false;
+	vector<int> position(G.Dimension(),-1);	//position of e^k in forms, or -1
+	for (int i=0;i<forms.size();++i) {
+		auto k=find_if(G.e().begin(),G.e().end(),[&forms,i] (const ex& x) {return x.is_equal(forms[i]);});
+		if (k==G.e().end()) return false;
+		position[k-G.e().begin()]=i;
+	}
+	int m=h.Dimension();
+	vector<ExVector> p;	//e^i is projected onto \sum_a p[i][a] h.e()[a]
+	for (int i=0;i<G.Dimension();++i) p.push_back(h.e().AllComponents(G.e()[i]));
+	vector<map<pair<int,int>,ex>> coefficients(forms.size());	//coefficients of h.e()[a]\wedge h.e()[b] in the projection of each d(forms[i])
+	for (auto& entry: *table) {
+		int i=entry.first.Lowest(), j=entry.first.Highest();
+		for (int a=0;a<m;++a)
+		for (int b=a+1;b<m;++b) {
+			ex w=p[i][a]*p[j][b]-p[i][b]*p[j][a];
+			if (w.is_zero()) continue;
+			for (auto& c: entry.second)
+				if (position[c.first]>=0) coefficients[position[c.first]][{a,b}]-=c.second*w;
+		}
+	}
+	d.assign(forms.size(),0);
+	for (int i=0;i<forms.size();++i)
+		for (auto& x: coefficients[i])
+			d[i]+=x.second.expand()*h.e()[x.first.first]*h.e()[x.first.second];
+	return true;
+}
+}
+
 template<> void LieSubgroup<false>::Check_ddZeroIfPossible()
 {
 	Check_ddZero();
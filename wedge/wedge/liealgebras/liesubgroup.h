@@ -32,6 +32,25 @@
 
 namespace Wedge {
 
+namespace internal {
+/** @internal @brief Compute the Lie brackets of the elements of a subalgebra from the table of structure constants of G
+ * @param G A Lie group
+ * @param subalgebra Linear combinations of the frame of G
+ * @param brackets (out) A matrix whose entry (i,j), for i<j, is set to \f$[X_i,X_j]\f$
+ * @return false if G has no table of structure constants, or some element of subalgebra is not a combination of the frame of G
+ */
+bool BracketsFromStructureConstants(const LieGroup& G, const exvector& subalgebra, vector<exvector>& brackets);
+
+/** @internal @brief Project the differentials of elements of the frame of G onto \f$\Lambda^2\mathfrak{h}^*\f$, using the table of structure constants of G
+ * @param G A Lie group
+ * @param h A subspace of the space of one-forms, whose complement determines the projection
+ * @param forms Elements of the frame of G
+ * @param d (out) The projections of the forms \f$d\alpha\f$, for \f$\alpha\f$ in forms
+ * @return false if G has no table of structure constants, or some element of forms is not in the frame of G
+ */
+bool ProjectedDifferentialsFromStructureConstants(const LieGroup& G, const Subspace<DifferentialOneForm>& h, const exvector& forms, exvector& d);
+}
+
 /** @brief Instances of LieSubgroup represent connected subgroups of a LieGroup.
  * 
  * @remark A connected Lie subgroup of a given group is determined by its Lie algebra.
@@ -55,11 +74,17 @@ public:
 	LieSubgroup(const LieGroupHasParameters<WithParams>& G, const exvector& subalgebra) : LieGroupHasParameters<WithParams>(G),
 		lieAlgebra(subalgebra, G.e(), TrivialPairingOperator<DifferentialOneForm>())
 	{			
-			Subspace<DifferentialForm> Lambda2(Wedge::TwoForms(lieAlgebra.e()));	// Space of two-forms on the Lie algebra of this subgroup
 			exvector simple;	//the simple one-forms appearing in e()			
 			GetSymbols<DifferentialOneForm>(simple, e().begin(),e().end());
-			for (exvector::const_iterator i=simple.begin();i!=simple.end();i++)				
-				Has_dTable::Declare_d(*i,Lambda2.Project(G.d(*i)));
+			exvector d_simple;
+			if (internal::ProjectedDifferentialsFromStructureConstants(G,lieAlgebra,simple,d_simple))
+				for (int i=0;i<simple.size();++i)
+					Has_dTable::Declare_d(simple[i],d_simple[i]);
+			else {
+				Subspace<DifferentialForm> Lambda2(Wedge::TwoForms(lieAlgebra.e()));	// Space of two-forms on the Lie algebra of this subgroup
+				for (exvector::const_iterator i=simple.begin();i!=simple.end();i++)				
+					Has_dTable::Declare_d(*i,Lambda2.Project(G.d(*i)));
+			}
 			Check_ddZeroIfPossible();			
 	} 
 	const Frame& e() const {return lieAlgebra.e();}
@@ -85,7 +110,8 @@ public:
  *  @param subalgebra A set of generators for a subalgebra \f$\mathfrak{h}\f$ of the Lie algebra \f$\mathfrak{g}\f$ of G.
  *  @exception WedgeException<std::runtime_error> Thrown if \f$\mathfrak{h}\f$ is not a subalgebra. 
  * 
- * This constructor computes the structure constants of the given subalgebra, and uses them to define a new LieGroup object
+ * This constructor computes the structure constants of the given subalgebra, and uses them to define a new LieGroup object.
+ * When possible, the brackets are obtained by restricting LieGroup::StructureConstantsTable() to the subalgebra.
  * @note If HasParameters=true, then \f$\mathfrak{h}\f$ is required to be a subalgebra for every choice of the parameters
 */ 
 	AbstractLieSubgroup(const LieGroupHasParameters<WithParams>& G, const exvector& subalgebra) :
@@ -116,11 +142,13 @@ protected:
 	{		
 		Frame frame(subalgebra);
 		assert(Dimension()==frame.size());
+		vector<exvector> brackets;
+		bool from_table=internal::BracketsFromStructureConstants(G,subalgebra,brackets);
 		exvector dei(Dimension());
 		for (int i=0;i<Dimension();i++)
 		for (int j=i+1;j<Dimension();j++)
 		{
-			ex eij=G.LieBracket(subalgebra[i],subalgebra[j]);			
+			ex eij=from_table? brackets[i][j] : G.LieBracket(subalgebra[i],subalgebra[j]);			
 			try {
 				exvector comps=frame.Components(eij);
 				assert(Dimension()==comps.size());
@@ -0,0 +1,313 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "modularliealgebra.h"
+#include <random>
+#include <unordered_map>
+#include "wedge/base/parallel.h"
+
+namespace Wedge {
+
+namespace internal {
+
+//invert a square matrix over F_p by Gauss-Jordan elimination
+ModularLieAlgebra::Matrix ModularInverse(ModularLieAlgebra::Matrix m, ModularLieAlgebra::Element p, ModularLieAlgebra::Element (*inverse)(ModularLieAlgebra::Element, ModularLieAlgebra::Element))
+{
+	int n=m.size();
+	ModularLieAlgebra::Matrix result(n,vector<ModularLieAlgebra::Element>(n,0));
+	for (int i=0;i<n;++i) result[i][i]=1;
+	for (int col=0;col<n;++col) {
+		int pivot=col;
+		while (pivot<n && m[pivot][col]==0) ++pivot;
+		if (pivot==n) throw WedgeException<std::runtime_error>("Frame is degenerate modulo p",__FILE__,__LINE__);
+		swap(m[pivot],m[col]); swap(result[pivot],result[col]);
+		auto inv=inverse(m[col][col],p);
+		for (int j=0;j<n;++j) {
+			m[col][j]=m[col][j]*inv%p;
+			result[col][j]=result[col][j]*inv%p;
+		}
+		for (int i=0;i<n;++i)
+			if (i!=col && m[i][col]!=0) {
+				auto factor=m[i][col];
+				for (int j=0;j<n;++j) {
+					m[i][j]=(m[i][j]+p-factor*m[col][j]%p)%p;
+					result[i][j]=(result[i][j]+p-factor*result[col][j]%p)%p;
+				}
+			}
+	}
+	return result;
+}
+
+//the subsets of {0,...,n-1} with k elements, represented as bitmasks, in increasing order
+vector<uint64_t> Subsets(int n, int k)
+{
+	vector<uint64_t> result;
+	if (k>n) return result;
+	if (k==0) {result.push_back(0); return result;}
+	uint64_t x=(uint64_t(1)<<k)-1, end=uint64_t(1)<<n;
+	while (x<end) {
+		result.push_back(x);
+		uint64_t u=x & -x, v=x+u;	//Gosper's hack
+		x=v+(((v^x)/u)>>2);
+	}
+	return result;
+}
+
+int PopCount(uint64_t x) {return __builtin_popcountll(x);}
+}
+
+ModularLieAlgebra::Element ModularLieAlgebra::Inverse(Element x, Element prime)
+{
+	Element result=1, k=prime-2;
+	while (k) {
+		if (k&1) result=result*x%prime;
+		x=x*x%prime;
+		k>>=1;
+	}
+	return result;
+}
+
+ModularLieAlgebra::Element ModularLieAlgebra::Reduce(const numeric& x, Element prime)
+{
+	if (!x.is_rational()) throw InvalidArgument(__FILE__,__LINE__,x);
+	numeric modulus(static_cast<long>(prime));
+	Element numer=mod(x.numer(),modulus).to_long(), denom=mod(x.denom(),modulus).to_long();
+	if (denom==0) throw InvalidArgument(__FILE__,__LINE__,x);
+	return numer*Inverse(denom,prime)%prime;
+}
+
+static ModularLieAlgebra::Element ReduceCoefficient(ex x, ModularLieAlgebra::Element prime)
+{
+	x=x.normal();
+	if (!is_a<numeric>(x)) throw InvalidArgument(__FILE__,__LINE__,x);
+	return ModularLieAlgebra::Reduce(ex_to<numeric>(x),prime);
+}
+
+ModularLieAlgebra::ModularLieAlgebra(const LieGroup& G, const exmap& specialization, Element prime, const exvector& frame) :
+	n(G.Dimension()), p(prime), c(n*n*n,0), epsilon(n,1)
+{
+	if (prime<2 || prime>=(Element(1)<<31)) throw OutOfRange(__FILE__,__LINE__,prime);
+	if (n>=64) throw OutOfRange(__FILE__,__LINE__,n);
+	for (int k=1;k<=n;++k) {
+		ex dek=G.d(G.e(k)).subs(specialization);
+		for (int i=1;i<=n;++i)
+		for (int j=i+1;j<=n;++j) {
+			Element x=ReduceCoefficient(TrivialPairing<DifferentialForm>(dek,G.e(i)*G.e(j)),p);
+			c[Index(j,i,k)]=x;
+			c[Index(i,j,k)]=Subtract(0,x);
+		}
+	}
+	if (frame.empty()) return;
+	if (frame.size()!=static_cast<size_t>(n)) throw OutOfRange(__FILE__,__LINE__,frame.size());
+	//frame[k]=sum_l A_kl e^l; the dual frame is f_i=sum_a B_ai e_a, with B the inverse of A, and e_l=sum_m A_ml f_m
+	Matrix A(n,vector<Element>(n));
+	for (int k=0;k<n;++k) {
+		ex fk=frame[k].subs(specialization);
+		for (int l=0;l<n;++l)
+			A[k][l]=ReduceCoefficient(TrivialPairing<DifferentialForm>(fk,G.e(l+1)),p);
+	}
+	Matrix B=internal::ModularInverse(A,p,Inverse);
+	vector<Element> T1(n*n*n,0), T2(n*n*n,0);
+	for (int a=1;a<=n;++a) for (int j=1;j<=n;++j) for (int l=1;l<=n;++l) {
+		Element x=0;
+		for (int b=1;b<=n;++b) x=Add(x,Multiply(B[b-1][j-1],c[Index(a,b,l)]));
+		T1[Index(a,j,l)]=x;
+	}
+	for (int i=1;i<=n;++i) for (int j=1;j<=n;++j) for (int l=1;l<=n;++l) {
+		Element x=0;
+		for (int a=1;a<=n;++a) x=Add(x,Multiply(B[a-1][i-1],T1[Index(a,j,l)]));
+		T2[Index(i,j,l)]=x;
+	}
+	for (int i=1;i<=n;++i) for (int j=1;j<=n;++j) for (int m=1;m<=n;++m) {
+		Element x=0;
+		for (int l=1;l<=n;++l) x=Add(x,Multiply(T2[Index(i,j,l)],A[m-1][l-1]));
+		c[Index(i,j,m)]=x;
+	}
+}
+
+bool ModularLieAlgebra::SatisfiesJacobi() const
+{
+	for (int i=1;i<=n;++i)
+	for (int j=i+1;j<=n;++j)
+	for (int k=j+1;k<=n;++k)
+	for (int m=1;m<=n;++m) {
+		Element x=0;
+		for (int l=1;l<=n;++l) {
+			x=Add(x,Multiply(Bracket(i,j,l),Bracket(l,k,m)));
+			x=Add(x,Multiply(Bracket(j,k,l),Bracket(l,i,m)));
+			x=Add(x,Multiply(Bracket(k,i,l),Bracket(l,j,m)));
+		}
+		if (x!=0) return false;
+	}
+	return true;
+}
+
+bool ModularLieAlgebra::IsUnimodular() const
+{
+	for (int i=1;i<=n;++i) {
+		Element trace=0;
+		for (int k=1;k<=n;++k) trace=Add(trace,Bracket(i,k,k));
+		if (trace!=0) return false;
+	}
+	return true;
+}
+
+ModularLieAlgebra::Matrix ModularLieAlgebra::d(int degree) const
+{
+	if (degree<0 || degree>n) throw OutOfRange(__FILE__,__LINE__,degree);
+	auto domain=internal::Subsets(n,degree), codomain=internal::Subsets(n,degree+1);
+	unordered_map<uint64_t,int> row;
+	for (size_t r=0;r<codomain.size();++r) row[codomain[r]]=r;
+	Matrix result(codomain.size(),vector<Element>(domain.size(),0));
+	for (size_t col=0;col<domain.size();++col) {
+		uint64_t I=domain[col];
+		int t=0;	//position of the index being differentiated, to compute the sign (-1)^t
+		for (int h=0;h<n;++h) {
+			uint64_t bit=uint64_t(1)<<h;
+			if (!(I&bit)) continue;
+			uint64_t rest=I&~bit, prefix=rest&(bit-1), suffix=rest&~(bit-1);
+			//de^h=-sum_{a<b} c_ab^h e^{ab}, and e^{prefix} e^{ab} e^{suffix} = sign e^{rest+a+b}
+			for (int a=0;a<n;++a) {
+				uint64_t abit=uint64_t(1)<<a;
+				if (rest&abit) continue;
+				for (int b=a+1;b<n;++b) {
+					uint64_t bbit=uint64_t(1)<<b;
+					if (rest&bbit) continue;
+					Element x=Bracket(a+1,b+1,h+1);
+					if (x==0) continue;
+					int inversions=internal::PopCount(prefix&~(abit-1))+internal::PopCount(prefix&~(bbit-1))
+						+internal::PopCount(suffix&(abit-1))+internal::PopCount(suffix&(bbit-1));
+					bool negative=(t+inversions+1)%2;
+					Element& entry=result[row[rest|abit|bbit]][col];
+					entry=negative? Subtract(entry,x) : Add(entry,x);
+				}
+			}
+			++t;
+		}
+	}
+	return result;
+}
+
+vector<int> ModularLieAlgebra::BettiNumbers() const
+{
+	if (!SatisfiesJacobi()) throw WedgeException<std::runtime_error>("Betti numbers requested for structure constants that do not satisfy d^2=0",__FILE__,__LINE__);
+	vector<int> ranks(n+1), betti(n+1);
+	for (int k=0;k<=n;++k) ranks[k]=Rank(d(k),p);
+	for (int k=0;k<=n;++k)
+		betti[k]=internal::Subsets(n,k).size()-ranks[k]-(k? ranks[k-1] : 0);
+	return betti;
+}
+
+void ModularLieAlgebra::SetMetric(const vector<int>& signs)
+{
+	if (signs.size()!=static_cast<size_t>(n)) throw OutOfRange(__FILE__,__LINE__,signs.size());
+	for (int i=0;i<n;++i)
+		if (signs[i]==1) epsilon[i]=1;
+		else if (signs[i]==-1) epsilon[i]=p-1;
+		else throw OutOfRange(__FILE__,__LINE__,signs[i]);
+}
+
+ModularLieAlgebra::Element ModularLieAlgebra::LeviCivita(int i, int j, int k) const
+{
+	//Koszul formula: 2g(nabla_X Y,Z)=g([X,Y],Z)-g([Y,Z],X)+g([Z,X],Y)
+	Element twice=Multiply(Bracket(i,j,k),epsilon[k-1]);
+	twice=Subtract(twice,Multiply(Bracket(j,k,i),epsilon[i-1]));
+	twice=Add(twice,Multiply(Bracket(k,i,j),epsilon[j-1]));
+	return Multiply(Multiply(twice,(p+1)/2),epsilon[k-1]);
+}
+
+ModularLieAlgebra::Matrix ModularLieAlgebra::RicciMatrix() const
+{
+	vector<Element> Gamma(n*n*n);
+	for (int i=1;i<=n;++i) for (int j=1;j<=n;++j) for (int k=1;k<=n;++k)
+		Gamma[Index(i,j,k)]=LeviCivita(i,j,k);
+	//R(e_i,e_j)e_k=nabla_i nabla_j e_k-nabla_j nabla_i e_k-nabla_{[e_i,e_j]}e_k; the Ricci tensor is obtained by contracting i with the output
+	Matrix ricci(n,vector<Element>(n,0));
+	for (int j=1;j<=n;++j)
+	for (int k=1;k<=n;++k) {
+		Element x=0;
+		for (int i=1;i<=n;++i)
+		for (int l=1;l<=n;++l) {
+			x=Add(x,Multiply(Gamma[Index(j,k,l)],Gamma[Index(i,l,i)]));
+			x=Subtract(x,Multiply(Gamma[Index(i,k,l)],Gamma[Index(j,l,i)]));
+			x=Subtract(x,Multiply(Bracket(i,j,l),Gamma[Index(l,k,i)]));
+		}
+		ricci[j-1][k-1]=x;
+	}
+	return ricci;
+}
+
+ModularLieAlgebra::Element ModularLieAlgebra::ScalarCurvature() const
+{
+	auto ricci=RicciMatrix();
+	Element s=0;
+	for (int i=0;i<n;++i) s=Add(s,Multiply(epsilon[i],ricci[i][i]));
+	return s;
+}
+
+int ModularLieAlgebra::Rank(Matrix m, Element prime)
+{
+	int rank=0;
+	int rows=m.size(), cols=rows? m[0].size() : 0;
+	for (int col=0;col<cols && rank<rows;++col) {
+		int pivot=rank;
+		while (pivot<rows && m[pivot][col]==0) ++pivot;
+		if (pivot==rows) continue;
+		swap(m[pivot],m[rank]);
+		Element inv=Inverse(m[rank][col],prime);
+		for (int j=col;j<cols;++j) m[rank][j]=m[rank][j]*inv%prime;
+		for (int i=rank+1;i<rows;++i)
+			if (m[i][col]!=0) {
+				Element factor=m[i][col];
+				for (int j=col;j<cols;++j)
+					m[i][j]=(m[i][j]+prime-factor*m[rank][j]%prime)%prime;
+			}
+		++rank;
+	}
+	return rank;
+}
+
+vector<ModularSample> ScreenParameters(const LieGroup& G, std::function<ModularSignature(const ModularLieAlgebra&)> test, int samples, 
+	lst parameters, const exvector& frame, ModularLieAlgebra::Element prime)
+{
+	if (parameters.nops()==0) {
+		for (int k=1;k<=G.Dimension();++k) CollectSymbols(G.d(G.e(k)),parameters);
+		for (auto& x: frame) CollectSymbols(x,parameters);
+	}
+	mt19937_64 generator;
+	vector<ModularSample> result;
+	int attempts=0;
+	while (result.size()<static_cast<size_t>(samples) && attempts++<10*samples) {
+		ModularSample sample;
+		for (auto& x: parameters) sample.parameters[x]=numeric(static_cast<long>(generator()%prime));
+		unique_ptr<ModularLieAlgebra> g;
+		try {
+			g.reset(new ModularLieAlgebra(G,sample.parameters,prime,frame));
+		}
+		catch (const std::invalid_argument&) {continue;}	//a denominator vanishes modulo p
+		catch (const std::domain_error&) {continue;}		//a denominator vanishes at this point
+		catch (const WedgeException<std::runtime_error>&) {continue;}	//the frame is degenerate
+		sample.signature=test(*g);
+		result.push_back(move(sample));
+	}
+	if (result.size()<static_cast<size_t>(samples)) LOG_WARN(result.size());
+	return result;
+}
+
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef MODULARLIEALGEBRA_H
+#define MODULARLIEALGEBRA_H
+
+#include "wedge/liealgebras/liegroup.h"
+#include <cstdint>
+
+/** @ingroup Manifolds */ 
+
+/** @{ 
+ * @file modularliealgebra.h
+ * @brief Lie algebras over a finite field, for screening families of Lie algebras
+ *
+ * When the structure constants of a Lie algebra depend on parameters, it is often convenient to know whether a condition can hold for 
+ * generic values of the parameters before solving it symbolically. This is achieved by specializing the parameters to random values, 
+ * reducing the structure constants modulo a prime and performing the computation in modular arithmetic.
+ *
+ * Notice that a condition holding for a value of the parameters modulo p does not imply that it holds in characteristic zero; the 
+ * converse however is true, as long as the value is a reduction of a rational value. Similarly, ranks computed modulo p are 
+ * lower bounds for the ranks in characteristic zero.
+ */
+
+namespace Wedge {
+
+using namespace GiNaC;
+using namespace std;
+
+/** @brief A Lie algebra over the finite field \f$\mathbb{F}_p\f$, represented by its structure constants
+ *
+ * Elements of the field are represented by integers in the range [0,p), where \f$p<2^{31}\f$.
+ * Indices are one-based, consistently with Manifold::e(int).
+ */
+class ModularLieAlgebra {
+public:
+	typedef uint64_t Element;		///< An element of the field, represented by an integer in the range [0,p)
+	typedef vector<vector<Element>> Matrix;	///< A matrix with entries in the field, as a vector of rows
+
+	static const Element DefaultPrime=2147483647;	///< The prime \f$2^{31}-1\f$
+
+/** @brief Reduce the Lie algebra of a Lie group modulo a prime
+ * @param G A Lie group
+ * @param specialization A substitution assigning a rational value to each parameter appearing in the structure constants
+ * @param prime A prime number less than \f$2^{31}\f$
+ * @param frame A left-invariant coframe relative to which the structure constants are computed, expressed in terms of G.e() with coefficients that may depend on the parameters; the default is G.e()
+ * @exception InvalidArgument Thrown if a structure constant or a coefficient of the frame is not rational after the substitution, or its denominator is divisible by the prime
+ * @exception WedgeException<std::runtime_error> Thrown if the frame is not a basis modulo the prime
+ */
+	ModularLieAlgebra(const LieGroup& G, const exmap& specialization, Element prime=DefaultPrime, const exvector& frame=exvector());
+
+	int Dimension() const {return n;}
+	Element Prime() const {return p;}
+/** @brief Return the structure constant \f$c_{ij}^k\f$, where \f$[e_i,e_j]=\sum_k c_{ij}^k e_k\f$
+ */
+	Element Bracket(int i, int j, int k) const {return c[Index(i,j,k)];}
+
+/** @brief Test whether the Jacobi identity holds, i.e. \f$d^2=0\f$
+ */
+	bool SatisfiesJacobi() const;
+/** @brief Test whether \f$\operatorname{tr}\operatorname{ad}X=0\f$ for all X
+ */
+	bool IsUnimodular() const;
+/** @brief Compute the matrix of the Chevalley-Eilenberg differential \f$d\colon\Lambda^k\to\Lambda^{k+1}\f$ 
+ * 
+ * Rows correspond to the basis of \f$\Lambda^{k+1}\f$, columns to the basis of \f$\Lambda^k\f$, both ordered lexicographically.
+ */
+	Matrix d(int degree) const;
+/** @brief Compute the Betti numbers of the Lie algebra over \f$\mathbb{F}_p\f$, as a zero-based vector
+ * @exception WedgeException<std::runtime_error> Thrown if the Jacobi identity does not hold
+ */
+	vector<int> BettiNumbers() const;
+/** @brief Set the metric relative to which the Levi-Civita connection is computed
+ * @param signs A vector of signs \f$\pm1\f$, such that the metric is \f$\sum_i \epsilon_i e^i\otimes e^i\f$; the default is the Riemannian metric making the frame orthonormal
+ */
+	void SetMetric(const vector<int>& signs);
+/** @brief Return the coefficient of \f$e_k\f$ in \f$\nabla_{e_i}e_j\f$, where \f$\nabla\f$ is the Levi-Civita connection of the left-invariant metric
+ */
+	Element LeviCivita(int i, int j, int k) const;
+/** @brief Compute the Ricci tensor of the left-invariant metric, \f$\operatorname{Ric}(Y,Z)=\operatorname{tr}(X\mapsto R(X,Y)Z)\f$
+ */
+	Matrix RicciMatrix() const;
+/** @brief Compute the scalar curvature of the left-invariant metric
+ */
+	Element ScalarCurvature() const;
+
+/** @brief Compute the rank of a matrix over \f$\mathbb{F}_p\f$
+ */
+	static int Rank(Matrix m, Element prime);
+/** @brief Reduce a rational number modulo a prime
+ * @exception InvalidArgument Thrown if x is not rational or its denominator is divisible by the prime
+ */
+	static Element Reduce(const numeric& x, Element prime);
+private:
+	int n;
+	Element p;
+	vector<Element> c;	//c[Index(i,j,k)] is the coefficient of e_k in [e_i,e_j]
+	vector<Element> epsilon;	//the metric
+
+	int Index(int i, int j, int k) const {return ((i-1)*n+j-1)*n+k-1;}
+	Element Add(Element x, Element y) const {return (x+y)%p;}
+	Element Subtract(Element x, Element y) const {return (x+p-y)%p;}
+	Element Multiply(Element x, Element y) const {return x*y%p;}
+	static Element Inverse(Element x, Element prime);
+};
+
+/** @brief The result of a test on a sample: a vector of integers, e.g. a single 0 or 1 for a pass/fail test, or a list of ranks
+ */
+typedef vector<int> ModularSignature;
+
+/** @brief A sample of the parameter space of a family of Lie algebras, with the signature computed on it
+ */
+struct ModularSample {
+	exmap parameters;		///< The value assigned to each parameter
+	ModularSignature signature;	///< The signature computed by the test
+};
+
+/** @brief Screen a family of Lie algebras by specializing the parameters to random elements of \f$\mathbb{F}_p\f$
+ * @param G A Lie group whose structure constants depend on parameters, e.g. a LieGroupFamily
+ * @param test A function computing the signature of a specialized Lie algebra, e.g. [] (const ModularLieAlgebra& g) {return ModularSignature{g.SatisfiesJacobi()};}
+ * @param samples The number of samples
+ * @param parameters The parameters to be specialized; by default, all the symbols appearing in the structure constants and the frame
+ * @param frame A left-invariant coframe, as in ModularLieAlgebra::ModularLieAlgebra
+ * @param prime The prime p
+ * @return A vector containing one ModularSample for each sample
+ *
+ * Values of the parameters for which the frame is degenerate or some denominator vanishes are discarded and replaced by a new sample.
+ * The pseudorandom generator is seeded deterministically, so that the results are reproducible.
+ */
+vector<ModularSample> ScreenParameters(const LieGroup& G, std::function<ModularSignature(const ModularLieAlgebra&)> test, int samples, 
+	lst parameters=lst{}, const exvector& frame=exvector(), ModularLieAlgebra::Element prime=ModularLieAlgebra::DefaultPrime);
+
+} /** @} */
+#endif
@@ -28,6 +28,7 @@
  */
  
 #include "linearcombinations.h"
+#include "wedge/base/zerotest.h"
 
 namespace Wedge {
 using namespace GiNaC;
@@ -113,7 +114,7 @@ public:
 			ex test;
 			for (int i=0;i<size();i++)
 			{
-				result[i]=result[i].expand();
+				result[i]=CachedExpand(result[i]);
 				test+=result[i]*e[i];
 			}			
 			//check whether v=test
@@ -122,7 +123,7 @@ public:
 			
 			if (lies_in_span==NULL) {
 				for (list<ex>::iterator i=eqns.begin();i!=eqns.end();i++)
-					if (!i->numer().expand().is_zero()) {
+					if (!CoefficientIsZero(*i)) {
 						LOG_WARN(v);
 						LOG_WARN(test);
 						LOG_WARN((v-test).expand());
@@ -134,8 +135,9 @@ public:
 			else {
 				*lies_in_span=true;
 				for (list<ex>::iterator i=eqns.begin();i!=eqns.end();i++)
-					if (!i->normal().is_zero()) {					
+					if (!CoefficientIsZero(*i)) {
 						*lies_in_span=false;
+						break;
 					}
 			}
 			return result;
@@ -18,6 +18,7 @@
  *  
  *******************************************************************************/
  #include "bilinearform.h"
+#include "wedge/base/normalform.h"
 
 namespace Wedge {
 
@@ -73,4 +74,239 @@ ex BilinearForm::Interior(ex v, ex w) const {
 	return result;
 }
 
+namespace internal {
+
+FrameMask FrameMask::FirstIndices(int n)
+{
+	FrameMask result;
+	if (n<64) result.low=(uint64_t(1)<<n)-1;
+	else {
+		result.low=~uint64_t(0);
+		result.high.assign((n-64)/64,~uint64_t(0));
+		if (n%64) result.high.push_back((uint64_t(1)<<(n%64))-1);
+	}
+	return result;
+}
+
+void FrameMask::Insert(int i)
+{
+	if (i<64) {low|=uint64_t(1)<<i; return;}
+	if (high.size()<i/64) high.resize(i/64);
+	high[i/64-1]|=uint64_t(1)<<(i%64);
+}
+
+int FrameMask::Size() const
+{
+	int result=__builtin_popcountll(low);
+	for (auto word: high) result+=__builtin_popcountll(word);
+	return result;
+}
+
+int FrameMask::CountFrom(int i) const
+{
+	int result=__builtin_popcountll(Word(i/64)&~((uint64_t(1)<<(i%64))-1));
+	for (int k=i/64+1;k<Words();++k) result+=__builtin_popcountll(Word(k));
+	return result;
+}
+
+int FrameMask::Lowest() const
+{
+	for (int k=0;k<Words();++k)
+		if (Word(k)) return 64*k+__builtin_ctzll(Word(k));
+	assert(false);
+	return -1;
+}
+
+int FrameMask::Highest() const
+{
+	int k=Words()-1;
+	assert(Word(k));
+	return 64*k+63-__builtin_clzll(Word(k));
+}
+
+bool FrameMask::IsSubsetOf(const FrameMask& other) const
+{
+	if (high.size()>other.high.size()) return false;
+	for (int k=0;k<Words();++k)
+		if (Word(k)&~other.Word(k)) return false;
+	return true;
+}
+
+FrameMask FrameMask::operator|(const FrameMask& other) const
+{
+	FrameMask result=high.size()>=other.high.size()? *this : other;
+	const FrameMask& shorter=high.size()>=other.high.size()? other : *this;
+	result.low|=shorter.low;
+	for (int k=0;k<shorter.high.size();++k) result.high[k]|=shorter.high[k];
+	return result;
+}
+
+bool FrameMask::operator<(const FrameMask& other) const
+{
+	if (high.size()!=other.high.size()) return high.size()<other.high.size();
+	for (int k=high.size()-1;k>=0;--k)
+		if (high[k]!=other.high[k]) return high[k]<other.high[k];
+	return low<other.low;
+}
+
+size_t FrameMask::Hash() const
+{
+	uint64_t result=low;
+	for (auto word: high) result=result*0x9e3779b97f4a7c15ULL ^ word;
+	return std::hash<uint64_t>()(result);
+}
+
+FrameMonomials::FrameMonomials(const Frame& e) : frame(e.begin(),e.end())
+{
+	for (int i=0;i<frame.size();++i) index[frame[i]]=i;
+}
+
+bool FrameMonomials::Supports(const Frame& e)
+{
+	set<ex,ex_is_less> distinct;
+	for (auto& x: e)
+		if (!is_a<DifferentialOneForm>(x) || !distinct.insert(x).second) return false;
+	return true;
+}
+
+bool FrameMonomials::RefersTo(const Frame& e) const
+{
+	if (e.size()!=frame.size()) return false;
+	for (int i=0;i<frame.size();++i)
+		if (!e[i].is_equal(frame[i])) return false;
+	return true;
+}
+
+bool FrameMonomials::IndexOf(const ex& oneform, int& i) const
+{
+	auto it=index.find(oneform);
+	if (it==index.end()) return false;
+	i=it->second;
+	return true;
+}
+
+bool FrameMonomials::Decompose(ex form, Terms& terms) const
+{
+	LambdaVectorNormalForm normal_form(form);
+	if (!normal_form.scalar_part.is_zero()) return false;
+	int i;
+	for (auto& term: normal_form.vector_part) {
+		if (!IndexOf(term.first,i)) return false;
+		terms.emplace_back(FrameMask::Singleton(i),term.second);
+	}
+	for (auto& term: normal_form.lambda_vector_part) {
+		FrameMask mask;
+		bool odd=false;
+		for (int k=0;k<term.first.nops();++k) {
+			if (!IndexOf(term.first.op(k),i)) return false;
+			if (mask.CountFrom(i)%2) odd=!odd;	//number of preceding elements with a larger index
+			mask.Insert(i);
+		}
+		terms.emplace_back(std::move(mask),odd? -term.second : term.second);
+	}
+	return true;
+}
+
+bool FrameMonomials::IsHomogeneous(const Terms& terms)
+{
+	for (auto& x: terms)
+		if (x.first.Size()!=terms.front().first.Size()) return false;
+	return true;
+}
+
+ex FrameMonomials::Monomial(const FrameMask& mask) const
+{
+	auto it=monomials.find(mask);
+	if (it!=monomials.end()) return it->second;
+	ex monomial=1;
+	for (int i=0;i<frame.size();++i)
+		if (mask.Contains(i)) monomial*=frame[i];
+	return monomials[mask]=monomial;
+}
+
+}
+
+const internal::FrameMonomials* BilinearFormWithFrame::Monomials() const
+{
+	if (!monomials_initialized) {
+		monomials_initialized=true;
+		if (internal::FrameMonomials::Supports(frame_)) {
+			monomials=make_shared<internal::FrameMonomials>(frame_);
+			diagonal=true;
+			for (int i=1;i<=frame_.size() && diagonal;++i)
+			for (int j=1;j<=frame_.size();++j)
+				if (i!=j && !MatrixEntry(i,j).is_zero()) {diagonal=false; break;}
+		}
+	}
+	return monomials.get();
+}
+
+ex BilinearFormWithFrame::GramMinor(const internal::FrameMask& I, const internal::FrameMask& J) const
+{
+	if (I.Size()!=J.Size()) return 0;
+	if (diagonal && I!=J) return 0;
+	auto key=make_pair(I,J);
+	auto it=gram_minors.find(key);
+	if (it!=gram_minors.end()) return it->second;
+	vector<int> rows, cols;
+	for (int i=0;i<monomials->Size();++i) {
+		if (I.Contains(i)) rows.push_back(i);
+		if (J.Contains(i)) cols.push_back(i);
+	}
+	ex minor;
+	if (diagonal) {
+		minor=1;
+		for (int i: rows) minor*=OnOneForms((*monomials)[i],(*monomials)[i]);
+	}
+	else {
+		matrix m(rows.size(),cols.size());
+		for (int i=0;i<rows.size();++i)
+		for (int j=0;j<cols.size();++j)
+			m(i,j)=OnOneForms((*monomials)[rows[i]],(*monomials)[cols[j]]);
+		minor=rows.empty()? ex(1) : m.determinant();
+	}
+	return gram_minors[key]=minor;
+}
+
+ex BilinearFormWithFrame::InteriorOnMonomials(const internal::FrameMask& I, const internal::FrameMask& J) const
+{
+	auto key=make_pair(I,J);
+	auto it=interior_products.find(key);
+	if (it!=interior_products.end()) return it->second;
+	return interior_products[key]=BilinearForm::Interior(monomials->Monomial(I),monomials->Monomial(J));
+}
+
+ex BilinearFormWithFrame::OnForms(ex v, ex w) const
+{
+	auto m=Monomials();
+	internal::FrameMonomials::Terms terms_v, terms_w;
+	if (!m || !m->Decompose(v,terms_v) || !m->Decompose(w,terms_w)) return BilinearForm::OnForms(v,w);
+	ex result;
+	if (diagonal) {
+		unordered_map<internal::FrameMask,ex,internal::FrameMaskHash> coefficients_w(terms_w.begin(),terms_w.end());
+		for (auto& x: terms_v) {
+			auto y=coefficients_w.find(x.first);
+			if (y!=coefficients_w.end()) result+=x.second*y->second*GramMinor(x.first,x.first);
+		}
+	}
+	else
+		for (auto& x: terms_v)
+		for (auto& y: terms_w)
+			result+=x.second*y.second*GramMinor(x.first,y.first);
+	return result.expand();
+}
+
+ex BilinearFormWithFrame::Interior(ex v, ex w) const
+{
+	auto m=Monomials();
+	internal::FrameMonomials::Terms terms_v, terms_w;
+	if (!m || !m->Decompose(v,terms_v) || !m->Decompose(w,terms_w)) return BilinearForm::Interior(v,w);
+	ex result;
+	for (auto& x: terms_v)
+	for (auto& y: terms_w)
+		if (x.first.Size()<=y.first.Size() && !(diagonal && !x.first.IsSubsetOf(y.first)))
+			result+=x.second*y.second*InteriorOnMonomials(x.first,y.first);
+	return result;
+}
+
 }
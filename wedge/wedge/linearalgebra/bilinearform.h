@@ -28,8 +28,80 @@
  
 #include "wedge/manifolds/manifold.h"
 #include "wedge/linearalgebra/vectorspace.h"
+#include <unordered_map>
 
 namespace Wedge {
+
+namespace internal {
+/** @internal @brief A multi-index, i.e. a set of zero-based indices, represented by a bitmask of arbitrary length
+ *
+ * The indices below 64 are stored in a single word, so that no memory is allocated for frames with fewer than 64 elements. Masks are ordered
+ * as the integers they represent.
+ */
+class FrameMask {
+	uint64_t low=0;	//the indices 0,...,63
+	vector<uint64_t> high;	//the indices from 64 on, 64 in each word; trailing zero words are removed, so that equal masks are represented in the same way
+	uint64_t Word(int k) const {return k==0? low : k<=high.size()? high[k-1] : 0;}
+	int Words() const {return high.size()+1;}
+public:
+	FrameMask()=default;
+	explicit FrameMask(uint64_t bits) : low{bits} {}
+	/** @brief The multi-index containing only i */
+	static FrameMask Singleton(int i) {FrameMask result; result.Insert(i); return result;}
+	/** @brief The multi-index \f$\{0,\dotsc,n-1\}\f$ */
+	static FrameMask FirstIndices(int n);
+	bool Contains(int i) const {return (Word(i/64)>>(i%64))&1;}
+	void Insert(int i);
+	/** @brief The number of indices in the multi-index */
+	int Size() const;
+	/** @brief The number of indices greater than or equal to i */
+	int CountFrom(int i) const;
+	/** @brief The smallest index; the multi-index must not be empty */
+	int Lowest() const;
+	/** @brief The largest index; the multi-index must not be empty */
+	int Highest() const;
+	bool IsSubsetOf(const FrameMask& other) const;
+	/** @brief The bitmask as a single word, for multi-indices whose elements are smaller than 64 */
+	uint64_t Bits() const {assert(high.empty()); return low;}
+	FrameMask operator|(const FrameMask& other) const;
+	bool operator==(const FrameMask& other) const {return low==other.low && high==other.high;}
+	bool operator!=(const FrameMask& other) const {return !(*this==other);}
+	bool operator<(const FrameMask& other) const;
+	size_t Hash() const;
+};
+
+struct FrameMaskHash {
+	size_t operator()(const FrameMask& I) const {return I.Hash();}
+};
+
+/** @internal @brief Decomposition of forms into monomials \f$e^I\f$ relative to a frame of simple one-forms, where multi-indices I are represented by bitmasks
+ */
+class FrameMonomials {
+	exvector frame;
+	map<ex,int,ex_is_less> index;
+	mutable unordered_map<FrameMask,ex,FrameMaskHash> monomials;
+	bool IndexOf(const ex& oneform, int& i) const;
+public:
+	typedef vector<pair<FrameMask,ex>> Terms;	///< Pairs (I,coefficient of e^I)
+
+	FrameMonomials(const Frame& frame);
+	/** @brief Test whether the frame consists of distinct simple one-forms */
+	static bool Supports(const Frame& frame);
+	bool RefersTo(const Frame& frame) const;
+	int Size() const {return frame.size();}
+	ex operator[](int i) const {return frame[i];}
+	FrameMask Full() const {return FrameMask::FirstIndices(frame.size());}
+	/** @brief Write a form as a linear combination of monomials; return false if it has a scalar part or contains elements not in the frame */
+	bool Decompose(ex form, Terms& terms) const;
+	static bool IsHomogeneous(const Terms& terms);
+	/** @brief The product of the elements of the frame in the multi-index, in increasing order */
+	ex Monomial(const FrameMask& mask) const;
+};
+
+struct MaskPairHash {
+	size_t operator()(const pair<FrameMask,FrameMask>& p) const {return p.first.Hash()*0x9e3779b97f4a7c15ULL ^ p.second.Hash();}
+};
+}
 /** @brief A bilinear form on the tangent space
 *
 * Abstract base class
@@ -49,7 +121,7 @@ public:
 	virtual ex Flat(ex vector) const =0;
 /** @brief Computes the interior product of a form into another
  */
-	ex Interior(ex v, ex w) const;
+	virtual ex Interior(ex v, ex w) const;
 	virtual ~BilinearForm() {}
 private:
 	ex OnSimpleForms(ex v, ex w) const;	//v and w are either DifferentialForm's or containers of the form [x,y,z] representing the form x\wedge y\wedge z
@@ -65,6 +137,18 @@ class BilinearFormWithFrame : public BilinearForm {
 public:
 /** @brief Initialize the coframe*/
 	BilinearFormWithFrame(const Frame& frame) : frame_(frame) {};
+/** @brief Computes the bilinear form on a pair of forms
+ *
+ * If the frame consists of simple one-forms, the forms are decomposed into monomials in the frame, and the Gram minors 
+ * \f$\langle e^I,e^J\rangle\f$ are computed once and stored; if the matrix is diagonal, only minors with I=J are considered. 
+ * Otherwise, the default implementation is used.
+ */
+	ex OnForms(ex v, ex w) const override;
+/** @brief Computes the interior product of a form into another
+ *
+ * If the frame consists of simple one-forms, the interior products of monomials are computed once and stored.
+ */
+	ex Interior(ex v, ex w) const override;
 /** @brief Computes the bilinear form on a pair of one-forms
  *
  * The one-forms are decomposed according to the reference frame; then the matrix provided by the subclass is used
@@ -133,6 +217,13 @@ protected:
 	int DimensionOfSpace() const {return frame_.size();}
 private:
 	mutable lst sharp_subs, flat_subs;
+	mutable shared_ptr<const internal::FrameMonomials> monomials;	//only set if the frame consists of simple one-forms
+	mutable bool monomials_initialized=false, diagonal=false;
+	mutable unordered_map<pair<internal::FrameMask,internal::FrameMask>,ex,internal::MaskPairHash> gram_minors, interior_products;
+
+	const internal::FrameMonomials* Monomials() const;
+	ex GramMinor(const internal::FrameMask& I, const internal::FrameMask& J) const;
+	ex InteriorOnMonomials(const internal::FrameMask& I, const internal::FrameMask& J) const;
 };
 
 /** @brief Riemannian scalar product represented by an orthonormal coframe
@@ -31,6 +31,7 @@
 #include "wedge/base/wedgealgebraic.h"
 #include "wedge/base/expressions.h"
 #include "wedge/linearalgebra/bilinear.h"
+#include <unordered_map>
 
 namespace Wedge {
 using namespace GiNaC;
@@ -519,6 +520,104 @@ template<typename T> bool IsOdd(ex e)
 }
 
 
+/** @brief Counters describing the table of unique decomposable elements of the exterior algebra over some V
+ *
+ * Decomposable elements obtained as products of elements of type Lambda1<V> are hash-consed, i.e. each distinct monomial
+ * is allocated once and shared by all the expressions containing it, so that equal monomials are represented by the same object. 
+ * Monomials that are no longer referenced by any expression are removed from the table periodically.
+ *
+ * @sa GetLambdaTableStatistics, SetLambdaHashConsing
+ */
+struct LambdaTableStatistics {
+	size_t size=0;		///< The number of monomials currently in the table
+	size_t created=0;	///< The number of monomials allocated so far
+	size_t reused=0;	///< The number of products that returned a monomial from the table instead of allocating a new one
+};
+
+namespace internal {
+inline bool& LambdaHashConsingEnabled() {
+	static bool enabled=true;
+	return enabled;
+}
+
+template<typename V> class LambdaTable {
+	unordered_multimap<unsigned,ex> table;	//indexed by a hash of the operands
+	LambdaTableStatistics statistics;
+	static constexpr size_t min_purge_size=1024;
+	size_t next_purge=min_purge_size;
+
+	static unsigned Hash(const exvector& operands) {
+		unsigned hash=operands.size();
+		for (auto& x: operands)
+			hash^=x.gethash()+0x9e3779b9+(hash<<6)+(hash>>2);
+		return hash;
+	}
+	static bool HasOperands(const ex& monomial, const exvector& operands) {
+		if (monomial.nops()!=operands.size()) return false;
+		for (size_t i=0;i<operands.size();++i)
+			if (!monomial.op(i).is_equal(operands[i])) return false;
+		return true;
+	}
+	static ex Create(const exvector& operands) {
+		return ex(
+			(new Lambda<V>(operands))->setflag(status_flags::dynallocated |status_flags::evaluated)
+		);
+	}
+public:
+	static LambdaTable& Instance() {
+		static LambdaTable instance;
+		return instance;
+	}
+/** @brief Return the monomial with the given operands, which are assumed to be sorted
+ */
+	ex Get(const exvector& operands) {
+		if (!LambdaHashConsingEnabled()) {
+			++statistics.created;
+			return Create(operands);
+		}
+		unsigned hash=Hash(operands);
+		auto range=table.equal_range(hash);
+		for (auto i=range.first;i!=range.second;++i)
+			if (HasOperands(i->second,operands)) {
+				++statistics.reused;
+				return i->second;
+			}
+		if (table.size()>=next_purge) {
+			Purge();
+			next_purge=max(min_purge_size,2*table.size());
+		}
+		++statistics.created;
+		return table.emplace(hash,Create(operands))->second;
+	}
+/** @brief Remove from the table the monomials that only appear in the table itself
+ */
+	void Purge() {
+		for (auto i=table.begin();i!=table.end();)
+			if (ex_to<basic>(i->second).get_refcount()==1) i=table.erase(i);
+			else ++i;
+	}
+	LambdaTableStatistics Statistics() const {
+		LambdaTableStatistics result=statistics;
+		result.size=table.size();
+		return result;
+	}
+};
+}
+
+/** @brief Enable or disable hash-consing of decomposable elements of the exterior algebra (enabled by default)
+ * 
+ * Disabling hash-consing is only useful for comparison purposes; monomials already in the table remain shared.
+ */
+inline void SetLambdaHashConsing(bool enabled) {internal::LambdaHashConsingEnabled()=enabled;}
+
+/** @brief Return the counters describing the table of unique monomials in the exterior algebra over V
+ */
+template<typename V> LambdaTableStatistics GetLambdaTableStatistics() {return internal::LambdaTable<V>::Instance().Statistics();}
+
+/** @brief Remove from the table of unique monomials in the exterior algebra over V the monomials that are no longer referenced
+ */
+template<typename V> void PurgeLambdaTable() {internal::LambdaTable<V>::Instance().Purge();}
+
 template<typename V> ex Lambda1<V>::eval_ncmul(const exvector & v) const
 {
 	exvector::const_iterator i=v.begin();
@@ -546,9 +645,7 @@ template<typename V> ex Lambda1<V>::eval_ncmul(const exvector & v) const
 		end--;
 	}
 	
-	ex result=ex(
-		(new Lambda<V>(s))->setflag(status_flags::dynallocated |status_flags::evaluated)
-	);
+	ex result=internal::LambdaTable<V>::Instance().Get(s);
 	if (change_sign) result=-result;	
 	return result;
 }
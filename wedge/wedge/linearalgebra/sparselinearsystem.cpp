@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "wedge/linearalgebra/sparselinearsystem.h"
+
+namespace Wedge {
+
+namespace internal {
+//subtracts c times row from result
+void SubtractMultiple(SparseLinearSystem::Row& result, const numeric& c, const SparseLinearSystem::Row& row) {
+	for (auto& entry: row) {
+		auto i=result.find(entry.first);
+		if (i==result.end()) result.emplace(entry.first,-c*entry.second);
+		else if ((i->second-=c*entry.second).is_zero()) result.erase(i);
+	}
+}
+}
+
+void SparseLinearSystem::AddEquation(Row row) {
+	for (auto i=row.begin();i!=row.end();) 
+		if (i->first<0 || i->first>=unknowns) throw OutOfRange(__FILE__,__LINE__,i->first);
+		else if (i->second.is_zero()) i=row.erase(i);
+		else ++i;
+	while (!row.empty()) {
+		auto leading=row.begin();
+		auto pivot=pivots.find(leading->first);
+		if (pivot==pivots.end()) {
+			numeric inverse=leading->second.inverse();
+			for (auto& entry: row) entry.second*=inverse;
+			pivots.emplace(leading->first,std::move(row));
+			return;
+		}
+		numeric c=leading->second;
+		internal::SubtractMultiple(row,c,pivot->second);
+	}
+}
+
+void SparseLinearSystem::AddEquation(const exvector& coefficients) {
+	if (coefficients.size()>unknowns) throw OutOfRange(__FILE__,__LINE__,coefficients.size());
+	Row row;
+	for (int i=0;i<coefficients.size();++i) {
+		if (!IsCoefficient(coefficients[i])) throw InvalidArgument(__FILE__,__LINE__,coefficients[i]);
+		if (!coefficients[i].is_zero()) row.emplace(i,ex_to<numeric>(coefficients[i]));
+	}
+	AddEquation(std::move(row));
+}
+
+vector<vector<numeric>> SparseLinearSystem::Solutions() const {
+	//reduce to row echelon form, eliminating each pivot unknown from the rows above it
+	map<int,Row> reduced=pivots;
+	for (auto i=reduced.rbegin();i!=reduced.rend();++i)
+		for (auto j=next(i);j!=reduced.rend();++j) {
+			auto entry=j->second.find(i->first);
+			if (entry!=j->second.end()) {
+				numeric c=entry->second;
+				internal::SubtractMultiple(j->second,c,i->second);
+			}
+		}
+	vector<vector<numeric>> result;
+	for (int free=0;free<unknowns;++free) {
+		if (reduced.count(free)) continue;
+		vector<numeric> solution(unknowns,0);
+		solution[free]=1;
+		for (auto& pivot: reduced) {
+			auto entry=pivot.second.find(free);
+			if (entry!=pivot.second.end()) solution[pivot.first]=-entry->second;
+		}
+		result.push_back(std::move(solution));
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef SPARSELINEARSYSTEM_H_
+#define SPARSELINEARSYSTEM_H_
+
+/** @ingroup LinearAlgebra */
+
+/** @{ 
+ * @file sparselinearsystem.h
+ * @brief Homogeneous linear systems with rational coefficients
+ */
+
+#include "wedge/base/wedgealgebraic.h"
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+/** @brief A homogeneous linear system with rational coefficients, stored as sparse rows over unknowns indexed by integers
+ *
+ * Equations are reduced against the previous ones as they are added, so that the system is always in echelon form; the 
+ * space of solutions is then obtained by back substitution. This is much faster than solving a system of symbolic equations
+ * when the coefficients are known to be rational, e.g. when they are obtained from the structure constants of a Lie algebra.
+ */
+class SparseLinearSystem {
+public:
+	typedef map<int,numeric> Row;	///< Pairs (j,a_j) representing the equation \f$\sum a_jx_j=0\f$; only nonzero coefficients are stored
+/** @brief Construct a system with no equations
+ * @param unknowns The number of unknowns
+ */
+	SparseLinearSystem(int unknowns) : unknowns{unknowns} {}
+/** @brief Test whether an expression can appear as a coefficient, i.e. it is a rational number
+ */
+	static bool IsCoefficient(ex x) {return is_a<numeric>(x) && ex_to<numeric>(x).is_rational();}
+/** @brief Add an equation to the system
+ * @param row The coefficients of the equation, indexed by zero-based unknowns 
+ * @throw OutOfRange if an unknown is out of range
+ */
+	void AddEquation(Row row);
+/** @brief Add an equation to the system
+ * @param coefficients The coefficients of the equation, indexed by zero-based unknowns; they must satisfy IsCoefficient
+ * @throw InvalidArgument if a coefficient is not a rational number
+ */
+	void AddEquation(const exvector& coefficients);
+	int Unknowns() const {return unknowns;}
+/** @brief The rank of the system */
+	int Rank() const {return pivots.size();}
+/** @brief Compute a basis of the space of solutions
+ * @return A list of vectors of length Unknowns(), one for each unknown that is not determined by the others
+ */
+	vector<vector<numeric>> Solutions() const;
+private:
+	int unknowns;
+	map<int,Row> pivots;	//rows indexed by the first unknown appearing in them, whose coefficient is one
+};
+
+} /** @} */
+#endif /*SPARSELINEARSYSTEM_H_*/
@@ -58,6 +58,18 @@ public:
 		if (cmp==0) return w.compare(o.w);
 		else return cmp;
 	}
+	void archive(archive_node& n) const override
+	{
+		Tensor::RegClass::archive(n);
+		n.add_ex("v",v);
+		n.add_ex("w",w);
+	}
+	void read_archive(const archive_node& n, lst& sym_lst) override
+	{
+		Tensor::RegClass::read_archive(n,sym_lst);
+		n.find_ex("v",v,sym_lst);
+		n.find_ex("w",w,sym_lst);
+	}
 /** @brief Overloaded substitution function 
 
 @note There are limitations to using subs to change the type of an object. In fact if v has type V and w has type W, the substitution v==w will not map \f$v\otimes v\f$ to \f$w\otimes w\f$. However, the substitution TensorProduct<V,V>(v,v)==w will map \f$v\otimes v\f$ to \f$w\f$. A similar limitation holds for objects of type Lambda<V>.
@@ -56,7 +56,7 @@ protected:
  *  @note If the standard frame of the manifold does not consist of simple elements, the action of d on simple elements can be
  *  recovered using LinearMapToSubstitutions()
 */
-	void Declare_d(ex alpha, ex beta) {assert(is_a<DifferentialOneForm>(alpha) || is_a<Function>(alpha)); table[alpha]=beta;}
+	void Declare_d(ex alpha, ex beta) {assert(is_a<DifferentialOneForm>(alpha) || is_a<Function>(alpha)); table[alpha]=beta; Invalidate_dCache();}
 private:
 	unique_ptr<DerivationOver<DifferentialForm,Function> > the_d_operator; ///< Pointer to visitor class used to compute the action of d  on forms on this manifold. The type is really dOperator, which is however only defined in manifold.cpp	
 	exmap table; ///< Table describing the action of d. Thus, table[e(i)] represents d(e(i))
@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "derivativecache.h"
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+void FunctionDerivativeCache::Evict(size_t target)
+{
+	while (entries.size()>target) {
+		index.erase(entries.back().key);
+		entries.pop_back();
+		++statistics.evictions;
+	}
+}
+
+void FunctionDerivativeCache::Insert(Key&& key, ex result)
+{
+	if (!capacity || index.count(key)) return;	//the key may have been inserted by a recursive computation
+	Evict(capacity-1);
+	entries.push_front(Entry{key,result});
+	index.emplace(std::move(key),entries.begin());
+}
+
+}
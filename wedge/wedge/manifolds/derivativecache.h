@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef DERIVATIVECACHE_H
+#define DERIVATIVECACHE_H
+
+/** @ingroup Manifolds 
+ *  @{ */
+/**  @file derivativecache.h 
+ * @brief Memoization of derivatives of functions
+ *
+ * Each Manifold object remembers the derivatives \f$Xf\f$ computed through its Lie derivative, where f is a Function (possibly 
+ * a LieDerivative or a derivative of a symbolic function, i.e. a multi-index applied to a function) and X a simple vector field.
+ * When the number of stored derivatives exceeds the capacity, the least recently used ones are evicted.
+ */
+#include <list>
+#include <unordered_map>
+#include "wedge/base/wedgealgebraic.h"
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+/** @brief Counters describing the state of a FunctionDerivativeCache
+ */
+struct FunctionDerivativeCacheStatistics {
+	size_t hits=0;		///< The number of derivatives taken from the cache
+	size_t misses=0;	///< The number of derivatives that had to be computed
+	size_t evictions=0;	///< The number of derivatives evicted to stay within the capacity
+	size_t entries=0;	///< The number of derivatives currently in the cache
+};
+
+/** @brief A table of derivatives \f$Xf\f$, indexed by the pair (X,f), with a least-recently-used eviction policy
+ *
+ * Copying a FunctionDerivativeCache copies its capacity, but not its content.
+ */
+class FunctionDerivativeCache {
+	struct Key {
+		ex X,f;
+		bool operator==(const Key& other) const {return X.is_equal(other.X) && f.is_equal(other.f);}
+	};
+	struct KeyHash {
+		size_t operator()(const Key& key) const {return key.X.gethash()*0x9e3779b9u ^ key.f.gethash();}
+	};
+	struct Entry {
+		Key key;
+		ex result;
+	};
+	list<Entry> entries;	//most recently used first
+	unordered_map<Key,list<Entry>::iterator,KeyHash> index;
+	size_t capacity;
+	FunctionDerivativeCacheStatistics statistics;
+
+	void Evict(size_t target);
+	void Insert(Key&& key, ex result);
+public:
+	static constexpr size_t DefaultCapacity=1<<16;	///< The default maximum number of derivatives stored
+
+	FunctionDerivativeCache(size_t capacity=DefaultCapacity) : capacity{capacity} {}
+	FunctionDerivativeCache(const FunctionDerivativeCache& o) : capacity{o.capacity} {}
+	FunctionDerivativeCache& operator=(const FunctionDerivativeCache& o) {Clear(); SetCapacity(o.capacity); return *this;}
+
+/** @brief Set the maximum number of derivatives stored; zero disables the cache
+ *
+ * Reducing the capacity evicts derivatives as needed.
+ */
+	void SetCapacity(size_t entries) {capacity=entries; Evict(capacity);}
+	size_t Capacity() const {return capacity;}
+/** @brief Remove all derivatives from the cache; counters are not affected
+ */
+	void Clear() {index.clear(); entries.clear();}
+	FunctionDerivativeCacheStatistics Statistics() const {
+		FunctionDerivativeCacheStatistics result=statistics;
+		result.entries=entries.size();
+		return result;
+	}
+/** @brief Return the derivative of f along X, invoking compute() if it is not in the cache
+ * @param X A vector field
+ * @param f A function
+ * @param compute A callable object returning \f$Xf\f$
+ *
+ * The computation may use the cache recursively.
+ */
+	template<typename Compute> ex Get(const ex& X, const ex& f, Compute&& compute) {
+		if (!capacity) return compute();
+		Key key{X,f};
+		auto i=index.find(key);
+		if (i!=index.end()) {
+			++statistics.hits;
+			entries.splice(entries.begin(),entries,i->second);
+			return i->second->result;
+		}
+		++statistics.misses;
+		ex result=compute();
+		Insert(std::move(key),result);
+		return result;
+	}
+};
+
+} /** @} */
+#endif
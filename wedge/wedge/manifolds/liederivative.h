@@ -90,6 +90,22 @@ public:
 		return Canonicalize(v,f,v.begin(),M);
 	}
 
+	void archive(archive_node& n) const override
+	{
+		RegClass::archive(n);
+		for (auto& Y : X) n.add_ex("X",Y);
+		n.add_ex("f",f);
+	}
+
+	void read_archive(const archive_node& n, lst& sym_lst) override
+	{
+		RegClass::read_archive(n,sym_lst);
+		X.clear();
+		ex Y,u;
+		for (int i=0;n.find_ex("X",Y,sym_lst,i);++i) X.push_back(ex_to<VectorField>(Y));
+		if (n.find_ex("f",u,sym_lst)) f=ex_to<Function>(u);
+	}
+
 	bool is_equal_same_type(const GiNaC::basic& o) const
 	{		
 		return compare_same_type(o)==0; 
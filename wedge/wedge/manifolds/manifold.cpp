@@ -71,11 +71,17 @@ void Manifold::Check_ddZero()
 {
 	for (int i=0;i<Dimension();i++)
 	{
-		ex ddei=NormalizeRoots(NormalForm<DifferentialForm>(d(d(e()[i]))));
+		ex ddei=d(dFrame()[i]);
+		if (RandomizedZeroTesting()) {	//cheap test first; if it fails, the exact computation below produces the diagnostics
+			list<ex> coeffs;
+			GetCoefficients<DifferentialForm>(coeffs,ddei);
+			if (all_of(coeffs.begin(),coeffs.end(),CoefficientIsZero)) continue;
+		}
+		ddei=NormalizeRoots(NormalForm<DifferentialForm>(ddei));
 		list<ex> eqns;
 		GetCoefficients<DifferentialForm>(eqns,ddei);
 		if (!eqns.empty()) {
-			LOG_ERROR(d(e()[i]));
+			LOG_ERROR(dFrame()[i]);
 			LOG_ERROR(ddei);			
 			throw ddNotZeroException(__FILE__,__LINE__,e()[i],*this);
 		}
@@ -87,15 +93,71 @@ ex Manifold::LieDerivative(ex X, ex f) const
 	return BilinearOperator(X,f,this).expand();	
 }
 
+const exvector& Manifold::dFrame() const {
+	if (d_frame.empty())
+		for (int k=0;k<Dimension();k++)
+			d_frame.push_back(d(e()[k]));
+	return d_frame;
+}
+
+ex Manifold::dSimple(ex alpha) const {
+	auto i=d_simple.find(alpha);
+	if (i!=d_simple.end()) return i->second;
+	ex dalpha=d(alpha);
+	d_simple.emplace(alpha,dalpha);
+	return dalpha;
+}
+
+const Manifold::FrameBracketTable& Manifold::FrameBrackets() const {
+	if (brackets.empty()) {
+		int n=Dimension();
+		const ExVector& dual=e().dual();
+		//[e_i,e_j]=-\sum_k de^k(e_i,e_j) e_k
+		brackets.assign(n,vector<vector<pair<int,ex>>>(n));
+		for (int k=0;k<n;k++) {
+			ex dek=dFrame()[k];
+			if (dek.is_zero()) continue;
+			for (int i=0;i<n;i++) {
+				ex hook=Hook(dual[i],dek);
+				if (hook.is_zero()) continue;
+				for (int j=i+1;j<n;j++) {
+					ex c=Hook(dual[j],hook).expand();
+					if (c.is_zero()) continue;
+					brackets[i][j].emplace_back(k,-c);
+					brackets[j][i].emplace_back(k,c);
+				}
+			}
+		}
+	}
+	return brackets;
+}
+
 ex Manifold::LieBracket(ex X, ex Y) const {
-	ex XY;
-	for (int k=1;k<=Dimension();k++)
-	{
-		ex XYk=LieDerivative(X,TrivialPairing<VectorField>(e(k),Y))-LieDerivative(Y,TrivialPairing<VectorField>(e(k),X));
-		XYk-=Hook(Y,Hook(X,d(e(k))));
-		XY+=XYk*e().dual()(k);
+	int n=Dimension();
+	const ExVector& dual=e().dual();
+	const FrameBracketTable& table=FrameBrackets();
+	exvector x(n), y(n);
+	for (int k=0;k<n;k++) {
+		x[k]=TrivialPairing<VectorField>(e()[k],X);
+		y[k]=TrivialPairing<VectorField>(e()[k],Y);
+	}
+	exvector XY(n);
+	for (int k=0;k<n;k++) {
+		if (!is_a<numeric>(y[k])) XY[k]+=LieDerivative(X,y[k]);
+		if (!is_a<numeric>(x[k])) XY[k]-=LieDerivative(Y,x[k]);
+	}
+	for (int i=0;i<n;i++) {
+		if (x[i].is_zero()) continue;
+		for (int j=0;j<n;j++) {
+			if (y[j].is_zero()) continue;
+			for (auto& c: table[i][j])
+				XY[c.first]+=x[i]*y[j]*c.second;
+		}
 	}
-	return XY;
+	ex result;
+	for (int k=0;k<n;k++)
+		result+=XY[k]*dual[k];
+	return result;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -109,7 +171,7 @@ ex Has_dTable::Apply(const VectorField& X,const Function& f) const
 //		for (it=table.begin();it!=table.end();++it)
 //			if (it->second==X)
 //				return f.Derive(it->first,*this);
-		return f.Derive(X,*this);
+		return CachedDerivative(X,f,[this,&X,&f] () {return f.Derive(X,*this);});
 	}
 }
 
@@ -166,6 +228,7 @@ Has_dTable::Has_dTable(const Has_dTable& o) : Manifold(o), the_d_operator(new dO
 
 Has_dTable& Has_dTable::operator=(const Has_dTable& o) {
 	table=o.table;
+	Invalidate_dCache();
 	return *this;
 }
 
@@ -32,6 +32,7 @@
 #include "wedge/linearalgebra/pforms.h"
 #include "wedge/manifolds/differentialform.h"
 #include "wedge/manifolds/function.h"
+#include "wedge/manifolds/derivativecache.h"
 
 namespace Wedge {
 using namespace  GiNaC;
@@ -121,6 +122,13 @@ public:
    * 
   */
 	virtual ex d(ex alpha) const;
+  /**
+   * @brief Return the exterior derivatives of the elements of the frame
+   * @returns The vector \f$de^1,\dotsc,de^n\f$
+   *
+   * The forms are computed on the first call and stored until the action of d changes (see Invalidate_dCache).
+  */
+	const exvector& dFrame() const;
   /**
    * @brief Return the vector space of p-forms
    * @param p An integer in the range [1,dimension]
@@ -155,20 +163,32 @@ public:
 /** @brief Compute the Lie bracket of two vector fields
  * @param X,Y Vector fields on the manifold
  * @return The vector field \f$[X,Y]\f$
+ *
+ * The brackets \f$[e_i,e_j]\f$ of the dual frame are taken from FrameBrackets(); the bracket of X and Y is then
+ * obtained by expanding bilinearly, adding the derivatives of the components of X and Y.
  */
 	virtual ex LieBracket(ex X, ex Y) const;
 
+/** @brief Set the maximum number of derivatives of functions stored by this manifold (see derivativecache.h)
+ * @param entries The capacity; zero disables the cache
+ */
+	void SetFunctionDerivativeCacheCapacity(size_t entries) {derivatives.SetCapacity(entries);}
+
+/** @brief Return the counters of the cache of derivatives of functions
+ */
+	FunctionDerivativeCacheStatistics GetFunctionDerivativeCacheStatistics() const {return derivatives.Statistics();}
+
 /** @brief For %internal use
 */
 	virtual ex Apply(const VectorField& X,const Function& f) const
 	{
-		return f.Derive(X,*this);
+		return CachedDerivative(X,f,[this,&X,&f] () {return f.Derive(X,*this);});
 	}
 /** @brief For %internal use
 */
 	ex Apply(const VectorField& X,const DifferentialForm& alpha) const
 	{
-		return Hook(X,d(alpha))+d(Hook(X,alpha));
+		return Hook(X,dSimple(alpha))+d(Hook(X,alpha));
 	}
 /** @brief For %internal use
 */
@@ -177,13 +197,32 @@ public:
 		//due to the way DerivationOver works, alpha is a DifferentialOneForm in disguise
 		assert(is_a<DifferentialOneForm>(alpha));
 		const DifferentialOneForm& beta=static_cast<const DifferentialOneForm&>(alpha);
-		return Hook(X,d(beta))+d(Hook(X,beta));
+		return Hook(X,dSimple(beta))+d(Hook(X,beta));
 	}
 	
 protected:
 	ex constant_function;	///< The constant function \f$f\equiv 1\f$ on this manifold
+	typedef vector<vector<vector<pair<int,ex>>>> FrameBracketTable;	///< The (i,j) entry lists the pairs (k,c) such that \f$[e_i,e_j]\f$ has component c along \f$e_k\f$
+/** @brief Return the brackets of the dual frame, computing them from dFrame() on the first call
+ */
+	const FrameBracketTable& FrameBrackets() const;
+/** @brief Discard the values of d, the brackets and the derivatives of functions stored by dFrame(), FrameBrackets() and Apply()
+ *
+ * Subclasses must call this function whenever the action of d changes.
+ */
+	void Invalidate_dCache() {d_frame.clear(); d_simple.clear(); brackets.clear(); derivatives.Clear();}
+/** @brief Return the derivative of f along X from the cache of derivatives, invoking compute() if it is not there
+ */
+	template<typename Compute> ex CachedDerivative(const VectorField& X, const Function& f, Compute&& compute) const {
+		return derivatives.Get(X,f,std::forward<Compute>(compute));
+	}
 private:
 	bool operator==(const Manifold&) const;	///< Not defined
+	ex dSimple(ex alpha) const;	///< d of a simple one-form, stored in d_simple
+	mutable exvector d_frame;	///< The forms de^k, if computed
+	mutable exmap d_simple;	///< The forms d(alpha) computed by dSimple
+	mutable FrameBracketTable brackets; ///< brackets[i][j] lists the nonzero components of [e_i,e_j] in the dual frame, if computed
+	mutable FunctionDerivativeCache derivatives;	///< The derivatives of functions computed by Apply
 };
 
 
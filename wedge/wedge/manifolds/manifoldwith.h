@@ -78,6 +78,7 @@ public:
 	void Declare_d(ex alpha, ex dalpha)
 	{
 		connection.Declare_d(alpha,dalpha);
+		Invalidate_dCache();
 	}
 
 /** @brief Impose conditions on the Christoffel symbols
@@ -88,6 +89,7 @@ public:
 	template<typename T> void DeclareNabla(ex X, ex alpha, ex nabla_Xalpha)
 	{
 		connection.DeclareNabla<T>(X, alpha,nabla_Xalpha);	
+		Invalidate_dCache();
 	}
 /** @brief Eliminate some connection parameters by imposing linear conditions on an expression
  * @param alpha An expression depending linearly on the parameters
@@ -101,6 +103,7 @@ public:
 	void DeclareZero(ex alpha)
 	{
 		connection.DeclareZero(alpha);
+		Invalidate_dCache();
 	}
 	
 /** @overload
@@ -108,6 +111,7 @@ public:
 	template<typename Iterator> void DeclareZero(Iterator begin, Iterator end)
 	{
 		connection.DeclareZero(begin,end);
+		Invalidate_dCache();
 	}		
 /** @brief Compute covariant derivative
  *  @param X A vector field 
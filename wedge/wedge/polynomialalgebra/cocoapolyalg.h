@@ -29,13 +29,36 @@
  * 
  */
 #include "CoCoA/library.H"
+#include "wedge/base/utilities.h"
 #include "wedge/convenience/latex.h"
 #include <sstream>
 namespace Wedge {
 
 namespace internal {
 
+/** @brief Convert an integer to a %CoCoA BigInt; integers that do not fit in a long are converted through their decimal expansion */
+inline CoCoA::BigInt ToBigInt(const numeric& n)
+{
+	static const numeric long_max(LONG_MAX);
+	if (abs(n)<=long_max) return CoCoA::BigInt(n.to_long());
+	return CoCoA::BigIntFromString(ToString(n));
+}
+
+/** @brief Convert a %CoCoA BigInt to a %GiNaC numeric; integers that do not fit in a long are converted through their decimal expansion */
+inline numeric ToNumeric(const CoCoA::BigInt& n)
+{
+	long as_long;
+	if (CoCoA::IsConvertible(as_long,n)) return numeric(as_long);
+	return numeric(ToString(n).c_str());
+}
 
+/** @brief Convert a rational coefficient of a %CoCoA polynomial to a %GiNaC numeric */
+inline numeric ToNumeric(CoCoA::ConstRefRingElem x)
+{
+	CoCoA::BigRat q;
+	if (!CoCoA::IsRational(q,x)) throw WedgeException<std::runtime_error>("Non-rational coefficient in polynomial",__FILE__,__LINE__);
+	return ToNumeric(CoCoA::num(q))/ToNumeric(CoCoA::den(q));
+}
 
 /** @brief Helper class to convert a %GiNaC polynomial into a %CoCoA polynomial */
 template<typename Coordinate> class PolynomialVisitor : public visitor, public add::visitor, public Coordinate::visitor, public mul::visitor, public power::visitor, public numeric::visitor {
@@ -65,9 +88,14 @@ public:
 	
 	void visit(const add& o)
 	{
-		result=RecursiveVisit(o.op(0));
-		for (int i=1;i<o.nops();i++)
-			result+=RecursiveVisit(o.op(i));			
+		//accumulate the terms in a single pass; the geobucket keeps the partial sum in buckets of increasing length, so each term is not merged into the whole sum
+		CoCoA::geobucket sum(CoCoA::SparsePolyRing(Qx));
+		for (int i=0;i<o.nops();i++)
+		{
+			CoCoA::RingElem term=RecursiveVisit(o.op(i));
+			sum.myAddClear(term,CoCoA::NumTerms(term));
+		}
+		CoCoA::AssignContent(result,sum);
 	}
 	void visit(const mul& o)
 	{
@@ -77,10 +105,11 @@ public:
 	}
 	void visit(const numeric& o)
 	{
-		if (o.is_real() && o.is_rational())	// i is considered a rational number
-		{
-			result=CoCoA::RingElem(Qx,o.numer().to_long())/CoCoA::RingElem(Qx,o.denom().to_long());
-		}			
+		if (!o.is_rational()) {
+			LOG_ERROR(o);
+			throw WedgeException<std::runtime_error>("Non-rational coefficient in polynomial",__FILE__,__LINE__);
+		}
+		result=CoCoA::RingElem(Qx,CoCoA::BigRat(ToBigInt(o.numer()),ToBigInt(o.denom())));
 	}
 	void visit(const power& o)
 	{
@@ -125,14 +154,35 @@ struct CocoaPolyAlgorithms{
 		Initializer() {static Message message; static CoCoA::GlobalManager cocoaFoundations;}
 	};
 	
-	static CoCoA::SparsePolyRing PolynomialRingOverQ(int indets) {
+	static vector<CoCoA::symbol> Indeterminates(int indets) {
 		vector<CoCoA::symbol> symbols;
 		for (int i=0;i<indets;++i) symbols.emplace_back("x",i);
+		return symbols;
+	}
+
+	static CoCoA::SparsePolyRing PolynomialRingOverQ(int indets) {
 		CoCoA::FractionField Q=CoCoA::RingQQ();
-		CoCoA::SparsePolyRing Qx = CoCoA::NewPolyRing(Q,symbols);
+		CoCoA::SparsePolyRing Qx = CoCoA::NewPolyRing(Q,Indeterminates(indets));
 		return Qx;
 	}
 
+/** @brief Set the number of primes used by the modular pre-check of IdealIsOne and RadicalContains
+ * @param primes An integer between 0 and MaxModularPrimes(); zero, the default, disables the check
+ *
+ * When the check is enabled, before computing a Groebner basis over \f$\mathbb{Q}\f$ the ideal is reduced modulo the given number of large primes, 
+ * skipping primes that divide a coefficient of the generators. If the ideal does not contain one modulo each of these primes, 
+ * it is declared not to contain one without further computation; otherwise the computation over \f$\mathbb{Q}\f$ is carried out.
+ * 
+ * @warning With the check enabled, IdealIsOne may incorrectly return false, namely if each of the primes divides a denominator of the coefficients expressing 
+ * one as a combination of the generators; the probability of this decreases with the number of primes. A return value of true is always correct.
+ */
+	static void SetModularPrimes(int primes) {
+		if (primes<0 || primes>MaxModularPrimes()) throw OutOfRange(__FILE__,__LINE__,primes);
+		ModularPrimesSetting()=primes;
+	}
+	static int ModularPrimes() {return ModularPrimesSetting();}	///< Return the number of primes used by the modular pre-check, or zero if disabled
+	static int MaxModularPrimes() {return 10;}	///< Return the maximum number of primes usable by the modular pre-check
+
 	template<typename Variable, typename Iterator> static exvector IdealReduce(const exvector& symbols, Iterator pol_begin, Iterator pol_end)
 	{		
 		if (symbols.empty())
@@ -237,6 +287,7 @@ struct CocoaPolyAlgorithms{
 			 	if (!(pol_begin++->is_zero())) return true;
 			 return false;
 		}
+		else if (!MaybeOne<Variable>(symbols,pol_begin,pol_end)) return false;
 		else {
 			CoCoA::SparsePolyRing Qx = PolynomialRingOverQ(symbols.size());
 			CoCoA::ideal I(Qx,Ginac2Cocoa<Variable>(Qx,symbols,pol_begin,pol_end));
@@ -298,7 +349,104 @@ struct CocoaPolyAlgorithms{
 //		}
 //	}
 
+/** @brief An ideal in a fixed %CoCoA ring, whose Groebner basis is computed by %CoCoA on the first query and reused by the following ones
+ *
+ * Only polynomials in the variables of the ideal can be tested or reduced; see Handles.
+ */
+	template<typename Variable> class Ideal {
+		exvector symbols;
+		exvector generators;
+		CoCoA::SparsePolyRing Qx;
+		vector<CoCoA::RingElem> indets;
+		CoCoA::ideal I;
+		mutable int is_one=-1;	//cached value of IsOne, or -1 if not yet computed
+	public:
+	/** @brief Construct the ideal generated by a range of polynomials
+	 * @param symbols The variables, which determine the ordering; must be nonempty
+	 * @param [pol_begin,pol_end) A range of polynomials in symbols
+	 */
+		template<typename Iterator> Ideal(const exvector& symbols, Iterator pol_begin, Iterator pol_end) :
+			symbols(symbols), generators(pol_begin,pol_end), Qx(PolynomialRingOverQ(symbols.size())), indets(CoCoA::indets(Qx)), 
+			I(Qx,Ginac2Cocoa<Variable>(Qx,symbols,generators.begin(),generators.end()))
+		{
+		}
+		const exvector& Variables() const {return symbols;}	///< Return the variables of the ring, in order
+
+	/** @brief Test whether a polynomial can be passed to Contains and Reduce, i.e. it only involves the variables of the ring */
+		bool Handles(ex p) const
+		{
+			set<ex,ex_is_less> symbols_in_p;
+			GetSymbols<Variable>(symbols_in_p,p);
+			for (auto& x : symbols_in_p)
+				if (find(symbols.begin(),symbols.end(),x)==symbols.end()) return false;
+			return true;
+		}
+		bool Contains(ex p) const {return CoCoA::IsElem(ToCocoa(p),I);}	///< Test whether the ideal contains a polynomial
+	/** @brief Test whether the ideal contains one, applying the modular pre-check if enabled (see SetModularPrimes) */
+		bool IsOne() const {
+			if (is_one<0) is_one=MaybeOne<Variable>(symbols,generators.begin(),generators.end()) && CoCoA::IsOne(I);
+			return is_one;
+		}
+	/** @brief Compute the Groebner basis now, rather than on the first query */
+		void ComputeGroebnerBasis() const {CoCoA::GBasis(I);}
+	/** @brief Return the normal form of a polynomial modulo the ideal */
+		ex Reduce(ex p) const
+		{
+			CoCoA::RingElem r=ToCocoa(p) % I;
+			return Cocoa2Ginac(symbols,&r,(&r)+1)[0];
+		}
+	private:
+		CoCoA::RingElem ToCocoa(ex p) const
+		{
+			try {
+				internal::PolynomialVisitor<Variable> v(Qx,symbols,indets);
+				return v.RecursiveVisit(p);
+			}
+			catch (CoCoA::ErrorInfo& exception) {
+				stringstream ss;
+				ss<<"CoCoA error in function Ideal::ToCocoa: ";
+				ss<<exception;
+				throw WedgeException<std::runtime_error>(ss.str(),__FILE__,__LINE__);
+			}
+		}
+	};
+
 private:
+	static int& ModularPrimesSetting() {
+		static int primes=0;
+		return primes;
+	}
+
+	//test whether a prime divides neither the numerator nor the denominator of any coefficient of a polynomial
+	static bool CoefficientsInvertibleModulo(long prime, ex p)
+	{
+		p=p.expand();
+		for (const_preorder_iterator i=p.preorder_begin();i!=p.preorder_end();++i)
+			if (is_a<numeric>(*i)) {
+				const numeric& n=ex_to<numeric>(*i);
+				if (!n.is_zero() && n.is_rational() && (irem(n.numer(),prime).is_zero() || irem(n.denom(),prime).is_zero())) return false;
+			}
+		return true;
+	}
+
+	//the modular pre-check: return false if the ideal does not contain one modulo each of the primes selected by SetModularPrimes, true otherwise
+	template<typename Variable, typename Iterator> static bool MaybeOne(const exvector& symbols, Iterator pol_begin, Iterator pol_end)
+	{
+		static const long primes[]={1073741789, 1073741783, 1073741741, 1073741723, 1073741719, 1073741717, 1073741689, 1073741671, 1073741663, 1073741651};
+		int tested=0;
+		for (int i=0;i<MaxModularPrimes() && tested<ModularPrimes();++i) {
+			bool lucky=true;
+			for (Iterator j=pol_begin;j!=pol_end && lucky;++j)
+				lucky=CoefficientsInvertibleModulo(primes[i],*j);
+			if (!lucky) continue;
+			CoCoA::SparsePolyRing Fpx = CoCoA::NewPolyRing(CoCoA::NewZZmod(primes[i]),Indeterminates(symbols.size()));
+			CoCoA::ideal I(Fpx,Ginac2Cocoa<Variable>(Fpx,symbols,pol_begin,pol_end));
+			if (CoCoA::IsOne(I)) return true;
+			++tested;
+		}
+		return tested==0;
+	}
+
 	template<typename Variable, typename Iterator> static vector<CoCoA::RingElem> Ginac2Cocoa(const CoCoA::SparsePolyRing& Qx, const exvector& symbols,Iterator pol_begin, Iterator pol_end)
 	{
 		try {			
@@ -323,16 +471,27 @@ private:
 		}
 	}
 
+	//convert polynomials term by term, reading off the coefficient and the exponent vector of each term
 	template<typename Iterator> static ExVector Cocoa2Ginac(const exvector& symbols,Iterator pol_begin, Iterator pol_end)
 	{
 		ExVector result;
+		vector<long> exponents;
 		while (pol_begin!=pol_end)
 		{	
-			stringstream str;		
-			str<<*pol_begin++;
-			LOG_DEBUG(str.str());
-			LOG_DEBUG(symbols);	
-			result.push_back(ParseCocoaExpression(symbols,str.str().c_str()));
+			const CoCoA::RingElem& f=*pol_begin++;
+			exvector terms;
+			terms.reserve(CoCoA::NumTerms(f));
+			for (CoCoA::SparsePolyIter i=CoCoA::BeginIter(f);!CoCoA::IsEnded(i);++i)
+			{
+				CoCoA::exponents(exponents,CoCoA::PP(i));
+				assert(exponents.size()<=symbols.size());
+				exvector factors;
+				factors.push_back(internal::ToNumeric(CoCoA::coeff(i)));
+				for (int k=0;k<exponents.size();++k)
+					if (exponents[k]) factors.push_back(pow(symbols[k],exponents[k]));
+				terms.push_back(dynallocate<mul>(factors));
+			}
+			result.push_back(dynallocate<add>(terms));
 		}
 		LOG_DEBUG(result);
 		return result;
@@ -528,7 +687,35 @@ private:
 			return pol.subs(back_subs);
 		}
 	};
+	template<typename Variable, typename Iterator> static PolynomialsOverQ<Variable> OverQ(const exvector& symbols, Iterator pol_begin, Iterator pol_end)
+	{
+		PolynomialsOverQ<Variable> r(symbols);
+		r.AddPolynomials(pol_begin,pol_end);
+		return r;
+	}
 public:
+/** @brief An ideal in a fixed %CoCoA ring, whose Groebner basis is computed by %CoCoA on the first query and reused by the following ones
+ *
+ * The roots appearing in the generators are replaced by extra variables once, on construction; polynomials passed to Contains and Reduce
+ * must have rational coefficients (see Handles).
+ */
+	template<typename Variable> class Ideal {
+		exvector symbols;
+		PolynomialsOverQ<Variable> r;
+		CocoaPolyAlgorithms::Ideal<Variable> overQ;
+	public:
+		template<typename Iterator> Ideal(const exvector& symbols, Iterator pol_begin, Iterator pol_end) :
+			symbols(symbols), r(OverQ<Variable>(symbols,pol_begin,pol_end)), overQ(r.symbols,r.polynomials.begin(),r.polynomials.end())
+		{
+		}
+		const exvector& Variables() const {return symbols;}
+		bool Handles(ex p) const {return p.info(info_flags::rational_polynomial) && overQ.Handles(p);}
+		bool Contains(ex p) const {return overQ.Contains(p);}
+		bool IsOne() const {return overQ.IsOne();}
+		void ComputeGroebnerBasis() const {overQ.ComputeGroebnerBasis();}
+		ex Reduce(ex p) const {return r.Convert(overQ.Reduce(p));}
+	};
+
 	template<typename Variable, typename Iterator> static exvector IdealReduce(const exvector& symbols, Iterator pol_begin, Iterator pol_end)
 	{
 		PolynomialsOverQ<Variable> r(symbols);
@@ -31,7 +31,9 @@
 #include "wedge/base/wedgealgebraic.h"
 #include "wedge/base/expressions.h"
 #include "wedge/linearalgebra/lambda.h"
+#include "wedge/base/parallel.h"
 #include <type_traits>
+#include <typeinfo>
 
 namespace Wedge {
  using namespace  GiNaC;
@@ -183,6 +185,8 @@ are used to modify the elements of PolyBasis directly.
    /** @brief Eliminate variables by taking square-free factorization and solving linear equations
    *  
    * Returns a list of substitutions that have been applied
+   *
+   * The equations are indexed by the variables occurring in them, so each substitution only touches, and re-simplifies, the equations containing the eliminated variable.
   */
 	lst Eliminate();
 protected:
@@ -204,6 +208,9 @@ private:
  * 
  * The template parameter PolyAlgorithms determines the implementation to use; only CoCoA is supported at the moment.
  * 
+ * The generators are converted to the ring of PolyAlgorithms once, and the resulting ideal (see CocoaPolyAlgorithms::Ideal) is kept until the basis is modified, 
+ * so that repeated calls to IdealContains, ReduceModuloIdeal and IdealIsOne reuse the same Groebner basis.
+ *
  * @warning Use PolyBasis for polynomials for which the Groebner basis implementation is not applicable. Recall that CoCoA only works with rational numbers. 
  */
 template<typename Variable, typename PolyAlgorithms> class PolyBasisImplementation : public PolyBasis<Variable>, public PolyAlgorithms::Initializer {
@@ -241,6 +248,8 @@ public:
  * @todo Consider defining a class Ideal, in analogy with VectorSpace.
  */
 	bool IdealContains(ex p) const {		
+		auto I=CachedIdeal();
+		if (I && I->Handles(p)) return I->Contains(p);
 		return PolyAlgorithms::template IdealContains<Variable>(this->variables, this->polynomials.begin(),this->polynomials.end(),p);
 	}
 
@@ -265,7 +274,8 @@ public:
  * @todo Consider defining a class Ideal, in analogy with VectorSpace.
  */
 	ex ReduceModuloIdeal(ex p) const {		
-		
+		auto I=CachedIdeal();
+		if (I && I->Handles(p)) return I->Reduce(p);
 		return PolyAlgorithms::template ElementModuloIdeal<Variable>(this->variables, this->polynomials.begin(),this->polynomials.end(),p);
 	}
 	
@@ -275,7 +285,8 @@ public:
  * @todo It would be nice to have a function that says whether V(I) is empty, over R or Q...  
  */
 	bool IdealIsOne() const {
-		
+		auto I=CachedIdeal();
+		if (I) return I->IsOne();
 		return PolyAlgorithms::template IdealIsOne<Variable>(this->variables, this->polynomials.begin(),this->polynomials.end());
 	}
 	
@@ -284,6 +295,63 @@ public:
 		PolyBasis<Variable>::Update();
 		MarkAsNotInitialized();			
 	}
+
+/** @brief Test whether the ideal contains each polynomial in a range
+ * @param [begin,end) A range of polynomials
+ * @return A vector whose i-th element is true if the i-th polynomial lies in this ideal
+ * 
+ * The ideal is converted once for all the polynomials. If SetParallelism has been called, the polynomials are distributed among worker processes,
+ * which inherit the Groebner basis computed by the calling process.
+ */
+	template<typename Iterator> vector<bool> IdealContains(Iterator begin, Iterator end) const
+	{
+		exvector contained=BatchMap(begin,end,"IdealContains",[this] (const ex& p) {return ex(IdealContains(p)? 1 : 0);});
+		vector<bool> result;
+		result.reserve(contained.size());
+		for (auto& x : contained) result.push_back(!x.is_zero());
+		return result;
+	}
+
+/** @brief Test whether the radical of this ideal contains each polynomial in a range
+ * @param [begin,end) A range of polynomials
+ * @return A vector whose i-th element is true if some power of the i-th polynomial lies in this ideal
+ * 
+ * If SetParallelism has been called, the polynomials are distributed among worker processes.
+ */
+	template<typename Iterator> vector<bool> RadicalContains(Iterator begin, Iterator end) const
+	{
+		exvector contained=BatchMap(begin,end,"RadicalContains",[this] (const ex& p) {return ex(RadicalContains(p)? 1 : 0);});
+		vector<bool> result;
+		result.reserve(contained.size());
+		for (auto& x : contained) result.push_back(!x.is_zero());
+		return result;
+	}
+
+/** @brief Reduce each polynomial in a range modulo this ideal
+ * @param [begin,end) A range of polynomials
+ * @return The reductions of the polynomials, in the same order
+ * 
+ * The ideal is converted once for all the polynomials. If SetParallelism has been called, the polynomials are distributed among worker processes.
+ */
+	template<typename Iterator> exvector ReduceModuloIdeal(Iterator begin, Iterator end) const
+	{
+		return BatchMap(begin,end,"ReduceModuloIdeal",[this] (const ex& p) {return ReduceModuloIdeal(p);});
+	}
+
+/** @brief Reduce the coefficients of each expression in a range modulo this ideal
+ * @param [begin,end) A range of linear combinations of objects of type T, with polynomials in Variable as coefficients
+ * @return The reductions of the expressions, in the same order
+ * 
+ * Example:
+ * @code
+ * matrix R=omega.CurvatureForm();
+ * exvector reduced=I.ReduceModuloIdeal<DifferentialForm>(R.begin(),R.end());
+ * @endcode
+ */
+	template<typename T, typename Iterator> exvector ReduceModuloIdeal(Iterator begin, Iterator end) const
+	{
+		return BatchMap(begin,end,string("ReduceModuloIdeal<")+typeid(T).name()+">",[this] (const ex& e) {return ReduceModuloIdeal<T>(e);});
+	}
 	
 /** @brief Reduce the coefficients of an expression modulo this ideal
  * @param e A linear combination of objects of type T, with polynomials in Variable as coefficients
@@ -304,11 +372,52 @@ public:
 	}
 	
 private:	
+	typedef typename PolyAlgorithms::template Ideal<Variable> Ideal;
 	mutable bool basis_is_reduced;
+	mutable shared_ptr<const Ideal> ideal;	///< The ideal in the ring of PolyAlgorithms, constructed on first use and discarded by Update
+	mutable shared_ptr<WorkerPool> pool;	///< The workers used by the last parallel batch, forked after computing the Groebner basis of ideal and discarded with it
+	mutable string pool_operation;	///< The operation performed by the workers in pool
 	
 	void MarkAsNotInitialized()
 	{		
 		basis_is_reduced=false;
+		ideal.reset();
+		pool.reset();
+	}
+
+	//apply f to each element of a range, in worker processes if parallelism is enabled; the workers are reused by the following batches performing the same operation
+	template<typename Iterator> exvector BatchMap(Iterator begin, Iterator end, const string& operation, const std::function<ex(const ex&)>& f) const
+	{
+		exvector arguments(begin,end);
+		if (Parallelism()==1 || arguments.size()<2) {
+			exvector result;
+			result.reserve(arguments.size());
+			for (auto& x : arguments) result.push_back(f(x));
+			return result;
+		}
+		auto I=CachedIdeal();
+		if (!pool || pool_operation!=operation || !pool->Workers()) {
+			pool.reset();	//terminate the old workers before forking new ones
+			//compute the Groebner basis before forking, so that the workers inherit it
+			if (I) I->ComputeGroebnerBasis();
+			pool=make_shared<WorkerPool>(f,lst(this->variables.begin(),this->variables.end()));
+			pool_operation=operation;
+		}
+		//symbols in the arguments which are not variables are matched by name when the results are read back
+		return pool->Map(arguments);
+	}
+
+	//return the ideal in the ring of PolyAlgorithms, or null if there are no variables; the ideal is rebuilt if the variables have been reordered
+	const Ideal* CachedIdeal() const
+	{
+		if (this->variables.empty()) return nullptr;
+		if (!ideal || !equal(this->variables.begin(),this->variables.end(),ideal->Variables().begin(),ideal->Variables().end(),
+				[] (const ex& x, const ex& y) {return x.is_equal(y);}))
+		{
+			ideal=make_shared<const Ideal>(this->variables,this->polynomials.begin(),this->polynomials.end());
+			pool.reset();	//the workers hold the old ideal
+		}
+		return ideal.get();
 	}
 };
 
@@ -329,40 +438,137 @@ template<typename Variable>  std::ostream& operator<<(std::ostream& out, const P
 }
 
 namespace internal {
-//helper class to single out the equation the form kx + p=0, with p not depending on x and of the lowest degree
-struct EqnToSolve {
-	exvector::iterator lowest;			//points to equation to solve
-	int lowestdegree=numeric_limits<int>::max();	//degree of lowest
-	ex var;						//variable to solve in, or zero if no variable found
-	//find equation to solve, starting from first. If nonzero constant is found, return the 1 ideal.
-	template<typename Parameter> EqnToSolve(PolyBasis<Parameter>& basis) {
-		const exvector& variables{basis.Variables()};
-		//we single out the equation of lowest degree that is degree one in at least one variable
-		for (exvector::iterator i=basis.begin();i!=basis.end();++i)
-		{
-			int deg=Degree<Poly<Parameter> >(*i);
-			if (deg==0 && !i->expand().is_zero()) {		//zeroes will be removed later
-				LOG_DEBUG(*i);
-				basis.clear(); basis.push_back(1);	//make this the 1 ideal
-				var=0;
-				return;
+
+//simplify a polynomial equation using square free factorization
+ex SimplifyPolyEqn(ex x,lst variables=lst());
+
+/* Helper class for PolyBasis::Eliminate. For each equation it records the degree and the variables in which the equation is linear, i.e. 
+ * has the form kx+p with k constant and p not depending on x; for each variable it records the equations where it occurs, 
+ * so that eliminating a variable only touches (and re-simplifies) the equations containing it.
+ */
+template<typename Parameter> class EliminationIndex {
+	struct Equation {
+		ex simplified;		//the equation, simplified by square free factorization
+		ex expanded;		//the same equation, expanded
+		int degree=0;
+		exset variables;	//the variables occurring in the equation
+		exvector linear;	//the variables in which the equation is linear, ordered as in the basis
+	};
+	vector<Equation> equations;
+	map<ex,set<int>,ex_is_less> occurrences;	//the equations in which each variable occurs
+	map<ex,int,ex_is_less> position;		//the position of each variable in the ordering of the basis
+	lst variables;
+	bool is_one=false;
+
+	//analyze a term, i.e. a product of factors, updating the variables of the equation; return the degree of the term
+	int AnalyzeTerm(const ex& term, Equation& equation, exset& candidates, exset& nonlinear)
+	{
+		int degree=0;
+		exvector term_variables;
+		auto analyze_factor=[&] (const ex& factor) {
+			if (is_a<Parameter>(factor)) {
+				++degree;
+				term_variables.push_back(factor);
+			}
+			else if (is_a<power>(factor) && is_a<Parameter>(factor.op(0)) && factor.op(1).info(info_flags::posint)) {
+				degree+=ex_to<numeric>(factor.op(1)).to_int();
+				term_variables.push_back(factor.op(0));
 			}
-			else if (deg<lowestdegree) {
-				exvector::const_iterator x=variables.begin();
-				//look for a variable x such that the equation has the form kx + p=0, with p not depending on x.
-				while (x!=variables.end() && Degree<Poly<Parameter> >(*i - i->subs(*x==0))!=1) ++x;
-				if (x!=variables.end()) {
-					var=*x;
-					lowest=i;
-					lowestdegree=deg;
-				}
+			else {
+				exset inner;
+				GetSymbols<Parameter>(inner,factor);
+				degree+=2*inner.size();
+				term_variables.insert(term_variables.end(),inner.begin(),inner.end());
 			}
+		};
+		if (is_a<mul>(term)) for (auto& factor : term) analyze_factor(factor);
+		else analyze_factor(term);
+		if (degree==1 && term_variables.size()==1) candidates.insert(term_variables[0]);
+		else nonlinear.insert(term_variables.begin(),term_variables.end());
+		equation.variables.insert(term_variables.begin(),term_variables.end());
+		return degree;
+	}
+
+	//compute the degree and variables of the k-th equation and add it to the index
+	void Analyze(int k)
+	{
+		Equation& equation=equations[k];
+		equation.expanded=equation.simplified.expand();
+		equation.degree=0;
+		equation.variables.clear();
+		equation.linear.clear();
+		if (equation.expanded.is_zero()) return;
+		exset candidates, nonlinear;
+		if (is_a<add>(equation.expanded)) 
+			for (auto& term : equation.expanded) equation.degree=max(equation.degree,AnalyzeTerm(term,equation,candidates,nonlinear));
+		else equation.degree=AnalyzeTerm(equation.expanded,equation,candidates,nonlinear);
+		if (equation.degree==0) is_one=true;
+		for (auto& x : candidates)
+			if (nonlinear.find(x)==nonlinear.end()) equation.linear.push_back(x);
+		sort(equation.linear.begin(),equation.linear.end(),[this] (const ex& x, const ex& y) {return position[x]<position[y];});
+		for (auto& x : equation.variables) occurrences[x].insert(k);
+	}
+
+	//remove the k-th equation from the index
+	void Remove(int k)
+	{
+		for (auto& x : equations[k].variables) occurrences[x].erase(k);
+	}
+public:
+	template<typename Iterator> EliminationIndex(Iterator begin, Iterator end, const exvector& variables) : variables(variables.begin(),variables.end())
+	{
+		for (int i=0;i<variables.size();++i) position[variables[i]]=i;
+		for (Iterator i=begin;i!=end;++i) {
+			equations.emplace_back();
+			equations.back().simplified=SimplifyPolyEqn(i->expand(),this->variables);
+			Analyze(equations.size()-1);
 		}
 	}
-};
 
-//simplify a polynomial equation using square free factorization
-ex SimplifyPolyEqn(ex x,lst variables=lst());
+	//true if some equation is a nonzero constant
+	bool IsOne() const {return is_one;}
+
+	//solve the equation of lowest degree which is linear in some variable, and substitute in the equations containing that variable; return false if there is no such equation
+	bool Eliminate(ex& var, ex& sol)
+	{
+		int lowest=-1;
+		for (int k=0;k<equations.size();++k)
+			if (!equations[k].linear.empty() && (lowest<0 || equations[k].degree<equations[lowest].degree)) lowest=k;
+		if (lowest<0) return false;
+		const Equation& equation=equations[lowest];
+		var=equation.linear.front();
+		sol=(-equation.expanded.coeff(var,0)/equation.expanded.coeff(var,1)).expand();
+		Remove(lowest);
+		equations[lowest]=Equation{};
+		ex sub=(var==sol);
+		set<int> touched;
+		touched.swap(occurrences[var]);
+		for (int k : touched) {
+			Remove(k);
+			try {
+				equations[k].simplified=SimplifyPolyEqn(equations[k].expanded.subs(sub),variables);
+			}
+			catch (...)
+			{
+				LOG_ERROR(equations[k].simplified);
+				LOG_ERROR(sub);
+				LOG_ERROR(variables);
+				throw;
+			}
+			Analyze(k);
+		}
+		return true;
+	}
+
+	//the nonzero equations, in their original order
+	exvector Equations() const
+	{
+		exvector result;
+		for (auto& equation : equations)
+			if (!equation.expanded.is_zero()) result.push_back(equation.simplified);
+		return result;
+	}
+};
 
 }
 
@@ -371,45 +577,19 @@ template<typename Parameter> lst PolyBasis<Parameter>::Eliminate() {
 	exvector eliminated_vars;
 	exvector replaced_with;
 	//the first thing to do would be taking the radical of the zero ideal, but I can't see how to get CoCoALib to do that.
-
-	for (auto& x: *this) x=internal::SimplifyPolyEqn(x.expand(),lst{variables.begin(),variables.end()});
-	while (true) {
-		internal::EqnToSolve eqn{*this}; 
-		
-		if (!eqn.var.is_zero()) {
-			ex sol=lsolve(*eqn.lowest==0,eqn.var);
-			assert(sol!=lst());
-			*eqn.lowest=0;
-			eliminated_vars.push_back(eqn.var);
-			replaced_with.push_back(sol);
-
-			ex sub=(eqn.var==sol);
-			for (auto& eq: replaced_with) {
-				eq= eq.subs(sub);	//eliminate var in subtitution
-			}
-			for (auto& x : polynomials)
-				if (!x.is_zero())	//eliminate var in equation
-				try {
-					 x=internal::SimplifyPolyEqn(x,lst{variables.begin(),variables.end()});
-				}
-				catch (...)
-				{
-					LOG_ERROR(x);
-					LOG_ERROR(sub);
-					LOG_ERROR(x.subs(sub));
-					LOG_ERROR(variables);
-					throw;
-				}
-			Update();
+	internal::EliminationIndex<Parameter> index(polynomials.begin(),polynomials.end(),variables);
+	ex var, sol;
+	while (!index.IsOne() && index.Eliminate(var,sol)) {
+		ex sub=(var==sol);
+		for (auto& eq: replaced_with) {
+			eq= eq.subs(sub);	//eliminate var in subtitution
 		}
-		else break;
-	}
-	//remove zeroes
-	iterator i=polynomials.begin();
-	while (i!=polynomials.end()) {
-		if (i->is_zero()) i=polynomials.erase(i);
-		else ++i;
+		eliminated_vars.push_back(var);
+		replaced_with.push_back(sol);
 	}
+	if (index.IsOne()) polynomials=exvector{1};	//make this the 1 ideal
+	else polynomials=index.Equations();
+	Update();
 	lst result;
 	assert(eliminated_vars.size()==replaced_with.size());
 	for (int i=0;i<eliminated_vars.size();++i)
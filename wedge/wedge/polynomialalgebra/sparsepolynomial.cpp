@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "wedge/polynomialalgebra/sparsepolynomial.h"
+#include "wedge/polynomialalgebra/cocoapolyalg.h"
+#include "wedge/base/parallel.h"
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+namespace internal {
+//the high bit of each packed exponent; exponents are less than 128, so sums of two exponents do not carry into the next byte
+static const uint64_t high_bits=0x8080808080808080ull;
+}
+
+void SparsePolynomial::AddTerm(const Monomial& monomial, const CoCoA::BigRat& coefficient)
+{
+	auto i=terms.find(monomial);
+	if (i==terms.end()) {
+		if (!CoCoA::IsZero(coefficient)) terms.emplace(monomial,coefficient);
+	}
+	else {
+		i->second+=coefficient;
+		if (CoCoA::IsZero(i->second)) terms.erase(i);
+	}
+}
+
+SparsePolynomial& SparsePolynomial::operator+=(const SparsePolynomial& p)
+{
+	for (auto& term : p.terms) AddTerm(term.first,term.second);
+	return *this;
+}
+
+SparsePolynomial& SparsePolynomial::operator-=(const SparsePolynomial& p)
+{
+	for (auto& term : p.terms) AddTerm(term.first,-term.second);
+	return *this;
+}
+
+SparsePolynomial SparsePolynomial::operator-() const
+{
+	SparsePolynomial result(*this);
+	for (auto& term : result.terms) term.second=-term.second;
+	return result;
+}
+
+SparsePolynomial SparsePolynomial::operator*(const SparsePolynomial& p) const
+{
+	SparsePolynomial result;
+	for (auto& term1 : terms)
+		for (auto& term2 : p.terms)
+			result.AddTerm(Multiply(term1.first,term2.first),term1.second*term2.second);
+	return result;
+}
+
+SparsePolynomial::Monomial SparsePolynomial::Multiply(const Monomial& m1, const Monomial& m2)
+{
+	assert(m1.size()==m2.size());
+	Monomial result(m1.size());
+	for (int i=0;i<m1.size();++i) {
+		result[i]=m1[i]+m2[i];
+		if (result[i] & internal::high_bits) throw ExponentOverflow(__FILE__,__LINE__);
+	}
+	return result;
+}
+
+bool SparsePolynomial::Divides(const Monomial& m1, const Monomial& m2)
+{
+	assert(m1.size()==m2.size());
+	//each byte of (m2|high_bits)-m1 keeps its high bit exactly when the corresponding exponent in m2 is not less than the one in m1
+	for (int i=0;i<m1.size();++i)
+		if ((((m2[i] | internal::high_bits)-m1[i]) & internal::high_bits)!=internal::high_bits) return false;
+	return true;
+}
+
+SparsePolynomial SparsePolynomial::ExactQuotient(const SparsePolynomial& p) const
+{
+	if (p.IsZero()) throw WedgeException<std::runtime_error>("Division by zero in SparsePolynomial",__FILE__,__LINE__);
+	auto leading=p.terms.rbegin();
+	SparsePolynomial quotient, remainder(*this);
+	while (!remainder.IsZero()) {
+		auto term=remainder.terms.rbegin();
+		if (!Divides(leading->first,term->first)) throw WedgeException<std::runtime_error>("Inexact division in SparsePolynomial",__FILE__,__LINE__);
+		Monomial monomial(term->first.size());
+		for (int i=0;i<monomial.size();++i) monomial[i]=term->first[i]-leading->first[i];
+		SparsePolynomial q(monomial,term->second/leading->second);
+		remainder-=q*p;
+		quotient+=q;
+	}
+	return quotient;
+}
+
+PolynomialRing::PolynomialRing(const exvector& variables) : variables(variables)
+{
+	CocoaPolyAlgorithms::Initializer{};
+	for (int i=0;i<variables.size();++i) position[variables[i]]=i;
+}
+
+SparsePolynomial PolynomialRing::One() const
+{
+	return SparsePolynomial(SparsePolynomial::Monomial((variables.size()+7)/8),CoCoA::BigRat(1));
+}
+
+SparsePolynomial PolynomialRing::FromEx(ex p) const
+{
+	p=p.expand();
+	SparsePolynomial result;
+	auto add_term=[this,&result] (const ex& term) {
+		SparsePolynomial::Monomial monomial((variables.size()+7)/8);
+		numeric coefficient=1;
+		auto add_factor=[this,&monomial,&coefficient,&term] (const ex& factor) {
+			ex base=factor;
+			int exponent=1;
+			if (is_a<numeric>(factor) && ex_to<numeric>(factor).is_rational()) {
+				coefficient*=ex_to<numeric>(factor);
+				return;
+			}
+			else if (is_a<power>(factor) && factor.op(1).info(info_flags::posint)) {
+				base=factor.op(0);
+				if (ex_to<numeric>(factor.op(1))>=128) throw OutOfRange(__FILE__,__LINE__,ex_to<numeric>(factor.op(1)).to_int());
+				exponent=ex_to<numeric>(factor.op(1)).to_int();
+			}
+			auto i=position.find(base);
+			if (i==position.end()) throw InvalidArgument(__FILE__,__LINE__,term);
+			monomial[i->second/8]+=static_cast<uint64_t>(exponent)<<(8*(7-i->second%8));
+		};
+		if (is_a<mul>(term)) for (auto& factor : term) add_factor(factor);
+		else add_factor(term);
+		result+=SparsePolynomial(monomial,CoCoA::BigRat(internal::ToBigInt(coefficient.numer()),internal::ToBigInt(coefficient.denom())));
+	};
+	if (is_a<add>(p)) for (auto& term : p) add_term(term);
+	else if (!p.is_zero()) add_term(p);
+	return result;
+}
+
+ex PolynomialRing::ToEx(const SparsePolynomial& p) const
+{
+	exvector terms;
+	terms.reserve(p.NumTerms());
+	for (auto& term : p.GetTerms()) {
+		exvector factors;
+		factors.push_back(internal::ToNumeric(CoCoA::num(term.second))/internal::ToNumeric(CoCoA::den(term.second)));
+		for (int i=0;i<variables.size();++i) {
+			int exponent=(term.first[i/8]>>(8*(7-i%8))) & 0xff;
+			if (exponent) factors.push_back(pow(variables[i],exponent));
+		}
+		terms.push_back(dynallocate<mul>(factors));
+	}
+	return dynallocate<add>(terms);
+}
+
+void SparsePolyLinAlgAlgorithms::IndependenceMatrix::ChooseLinearlyIndependentRows()
+{
+	try {
+		EliminateSparse();
+	}
+	catch (const InvalidArgument&) {
+		LOG_INFO("Matrix entries are not polynomials with rational coefficients; falling back to GinacLinAlgAlgorithms");
+		independentRows.clear();
+		GinacLinAlgAlgorithms::IndependenceMatrix::ChooseLinearlyIndependentRows();
+	}
+	catch (const OutOfRange&) {
+		LOG_INFO("Exponents in matrix entries are too large for SparsePolynomial; falling back to GinacLinAlgAlgorithms");
+		independentRows.clear();
+		GinacLinAlgAlgorithms::IndependenceMatrix::ChooseLinearlyIndependentRows();
+	}
+	catch (const ExponentOverflow&) {
+		LOG_INFO("Exponent overflow during elimination; falling back to GinacLinAlgAlgorithms");
+		independentRows.clear();
+		GinacLinAlgAlgorithms::IndependenceMatrix::ChooseLinearlyIndependentRows();
+	}
+}
+
+void SparsePolyLinAlgAlgorithms::IndependenceMatrix::EliminateSparse()
+{
+	lst symbols;
+	for (int i=0;i<rows();i++)
+		for (int j=0;j<cols();j++)
+			CollectSymbols(M(i,j),symbols);
+	PolynomialRing R(exvector(symbols.begin(),symbols.end()));
+	vector<SparsePolynomial> m;
+	m.reserve(rows()*cols());
+	for (int i=0;i<rows();i++)
+		for (int j=0;j<cols();j++)
+			m.push_back(R.FromEx(M(i,j)));
+	vector<int> col(cols());
+	for (int j=0;j<cols();j++) col[j]=j;
+	auto entry=[this,&m,&col] (int r, int c) -> SparsePolynomial& {return m[r*cols()+col[c]];};
+	SparsePolynomial last_pivot=R.One();
+	int c0=0;
+	for (int r0=0; r0<rows() && c0<cols(); ++r0) {
+		//choose the nonzero entry in row r0 with the most zeros below, as in GinacLinAlgAlgorithms
+		int candidate_col=-1, max_zeros_below=-1;
+		for (int k=c0;k<cols();++k) {
+			if (entry(r0,k).IsZero()) continue;
+			int zeros_below=0;
+			for (int i=r0+1;i<rows();i++)
+				if (entry(i,k).IsZero()) ++zeros_below;
+			if (zeros_below>max_zeros_below) {
+				candidate_col=k;
+				max_zeros_below=zeros_below;
+			}
+		}
+		if (candidate_col<0) continue;
+		swap(col[candidate_col],col[c0]);
+		independentRows.push_back(r0);
+		for (int r2=r0+1; r2<rows(); ++r2)
+			for (int c=c0+1; c<cols(); ++c)
+				entry(r2,c)=(entry(r0,c0)*entry(r2,c)-entry(r2,c0)*entry(r0,c)).ExactQuotient(last_pivot);
+		last_pivot=entry(r0,c0);
+		++c0;
+	}
+}
+
+}
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef SPARSEPOLYNOMIAL_H
+#define SPARSEPOLYNOMIAL_H
+
+/** @ingroup ExternalAlgorithms */ 
+
+/** @{ 
+ * @file sparsepolynomial.h
+ * @brief A native representation of polynomials with rational coefficients, and linear algebra algorithms based on it
+ *
+ * Coefficients depending polynomially on parameters (e.g. StructureConstant or ConnectionParameter objects) are represented by %GiNaC
+ * as generic expression trees, which need to be expanded at each step of an elimination. A SparsePolynomial is instead stored as a sorted
+ * list of terms, each consisting of a packed exponent vector and a GMP rational coefficient; conversions to and from ex take place in PolynomialRing.
+ */
+
+#include "wedge/linearalgebra/ginaclinalg.h"
+#include "CoCoA/BigRat.H"
+#include <map>
+#include <cstdint>
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+/** @brief Exception thrown when the product of two monomials has an exponent which does not fit in the packed representation
+ */
+class ExponentOverflow : public WedgeException<std::runtime_error> {
+public:
+	ExponentOverflow(const char* in_file, int at_line) : WedgeException<std::runtime_error>("Exponent overflow in SparsePolynomial",in_file,at_line) {}
+};
+
+/** @brief A polynomial with rational coefficients
+ * 
+ * Exponent vectors are packed with 8 bits per variable, so that the product of monomials reduces to a sum of machine words; exponents
+ * are required to be less than 128. Terms are sorted in lexicographic order, the first variable being the most significant.
+ * Polynomials in different rings should not be mixed.
+ */
+class SparsePolynomial {
+public:
+	typedef vector<uint64_t> Monomial;		///< A packed exponent vector
+	typedef map<Monomial,CoCoA::BigRat> Terms;	///< The terms of a polynomial, mapping each monomial to its (nonzero) coefficient
+
+	SparsePolynomial() {}	///< Construct the zero polynomial
+/** @brief Construct a polynomial with a single term
+ * @param monomial A packed exponent vector
+ * @param coefficient The coefficient
+ */
+	SparsePolynomial(const Monomial& monomial, const CoCoA::BigRat& coefficient) {
+		if (!CoCoA::IsZero(coefficient)) terms[monomial]=coefficient;
+	}
+
+	bool IsZero() const {return terms.empty();}	///< Test whether this is the zero polynomial
+	int NumTerms() const {return terms.size();}	///< Return the number of terms
+	const Terms& GetTerms() const {return terms;}	///< Return the terms, in increasing lexicographic order
+
+	SparsePolynomial& operator+=(const SparsePolynomial& p);
+	SparsePolynomial& operator-=(const SparsePolynomial& p);
+	SparsePolynomial operator*(const SparsePolynomial& p) const;
+	SparsePolynomial operator-() const;
+	SparsePolynomial operator+(const SparsePolynomial& p) const {SparsePolynomial result(*this); return result+=p;}
+	SparsePolynomial operator-(const SparsePolynomial& p) const {SparsePolynomial result(*this); return result-=p;}
+	bool operator==(const SparsePolynomial& p) const {return terms==p.terms;}
+	bool operator!=(const SparsePolynomial& p) const {return !(*this==p);}
+
+/** @brief Divide by a polynomial, when the division is known to be exact (e.g. in fraction-free elimination)
+ * @param p A nonzero polynomial dividing this polynomial
+ * @return The quotient
+ * @exception WedgeException<std::runtime_error> if p does not divide this polynomial
+ */
+	SparsePolynomial ExactQuotient(const SparsePolynomial& p) const;
+
+	static Monomial Multiply(const Monomial& m1, const Monomial& m2);	///< Return the product of two monomials
+	static bool Divides(const Monomial& m1, const Monomial& m2);	///< Test whether m1 divides m2
+private:
+	Terms terms;
+	void AddTerm(const Monomial& monomial, const CoCoA::BigRat& coefficient);
+};
+
+/** @brief A ring of polynomials with rational coefficients in an ordered list of variables, converting between ex and SparsePolynomial
+ * 
+ * Example:
+ * @code
+ * PolynomialRing R(exvector{a,b});
+ * SparsePolynomial p=R.FromEx(a*a-2*b), q=R.FromEx(a+b);
+ * ex pq=R.ToEx(p*q);
+ * @endcode
+ */
+class PolynomialRing {
+	exvector variables;
+	map<ex,int,ex_is_less> position;
+public:
+/** @brief Construct the ring of polynomials in the given variables
+ * @param variables A list of distinct symbols
+ */
+	explicit PolynomialRing(const exvector& variables);
+	const exvector& Variables() const {return variables;}	///< Return the variables of the ring
+	SparsePolynomial One() const;	///< Return the constant polynomial one
+
+/** @brief Convert an expression to a polynomial
+ * @param p An expression which is a polynomial in the variables of the ring, with rational coefficients
+ * @exception InvalidArgument if p is not of the required form
+ */
+	SparsePolynomial FromEx(ex p) const;
+/** @brief Convert a polynomial to an expression
+ */
+	ex ToEx(const SparsePolynomial& p) const;
+};
+
+/** @brief Linear algebra algorithms for matrices whose entries are polynomials with rational coefficients
+ *
+ * Independent rows are computed by fraction-free (Bareiss) elimination in the ring of polynomials in the symbols appearing in the matrix,
+ * represented by SparsePolynomial. If some entry is not a polynomial with rational coefficients, or an exponent exceeds the packed representation
+ * either in the input or during the elimination, the algorithm of GinacLinAlgAlgorithms is used instead.
+ * 
+ * Example:
+ * @code
+ * VectorSpace<DifferentialForm,SparsePolyLinAlgAlgorithms> V(forms.begin(),forms.end());
+ * @endcode
+ */
+struct SparsePolyLinAlgAlgorithms : public GinacLinAlgAlgorithms {
+	/** @brief A class to compute a minimal set of independent rows in a matrix
+	 */	
+	class IndependenceMatrix : public GinacLinAlgAlgorithms::IndependenceMatrix {
+	public:
+		using GinacLinAlgAlgorithms::IndependenceMatrix::IndependenceMatrix;
+	/** @brief Compute a minimal set of linearly independent rows
+	 * 
+	 * The set of independent rows can subsequently be retrieved as the range
+	 * [IndependentRowsBegin(),IndependentRowsEnd())
+	 */
+		void ChooseLinearlyIndependentRows();
+	private:
+		void EliminateSparse();	//throws if the entries cannot be represented as SparsePolynomial's throughout the elimination
+	};
+};
+
+inline ostream& operator<<(ostream& os,  const SparsePolyLinAlgAlgorithms::IndependenceMatrix& m)
+{
+	return internal::Output<SparsePolyLinAlgAlgorithms>(os,m);
+}
+
+} /** @} */
+#endif
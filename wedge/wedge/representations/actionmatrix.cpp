@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "wedge/representations/actionmatrix.h"
+
+namespace Wedge {
+
+void SparseEndomorphism::Add(ZeroBased i, ZeroBased j, ex a) {
+	auto& column=columns[j];
+	auto entry=find_if(column.begin(),column.end(),[i] (const pair<ZeroBased,ex>& x) {return x.first==i;});
+	if (entry==column.end()) {
+		if (!a.is_zero()) column.emplace_back(i,a);
+	}
+	else {
+		entry->second=(entry->second+a).expand();
+		if (entry->second.is_zero()) column.erase(entry);
+	}
+}
+
+matrix SparseEndomorphism::AsMatrix() const {
+	matrix result(Dimension(),Dimension());
+	for (int j=0;j<Dimension();++j)
+		for (auto& entry: columns[j])
+			result(entry.first,j)=entry.second;
+	return result;
+}
+
+exvector SparseEndomorphism::Apply(const exvector& v) const {
+	if (v.size()!=Dimension()) throw InvalidArgument(__FILE__,__LINE__,lst(v.begin(),v.end()));
+	exvector result(Dimension());
+	for (int j=0;j<Dimension();++j)
+		if (!v[j].is_zero())
+			for (auto& entry: columns[j])
+				result[entry.first]+=entry.second*v[j];
+	return result;
+}
+
+SparseEndomorphism::Terms SparseEndomorphism::OnMonomial(uint64_t I) const {
+	if (Dimension()>64) throw OutOfRange(__FILE__,__LINE__,Dimension());
+	map<uint64_t,ex> result;
+	for (int j=0;j<Dimension();++j) {
+		uint64_t bit_j=uint64_t{1}<<j;
+		if (!(I&bit_j)) continue;
+		for (auto& entry: columns[j]) {
+			uint64_t bit_i=uint64_t{1}<<entry.first;
+			if (entry.first==j) result[I]+=entry.second;
+			else if (!(I&bit_i)) {
+				//replacing e_j with e_i, then moving e_i past the elements with index between i and j
+				uint64_t between= entry.first<j? (bit_j-1)&~(2*bit_i-1) : (bit_i-1)&~(2*bit_j-1);
+				bool odd=__builtin_popcountll(I&between)%2;
+				result[(I^bit_j)|bit_i]+= odd? -entry.second : entry.second;
+			}
+		}
+	}
+	Terms terms;
+	for (auto& x: result) {
+		ex coefficient=x.second.expand();
+		if (!coefficient.is_zero()) terms.emplace_back(x.first,coefficient);
+	}
+	return terms;
+}
+
+vector<uint64_t> SparseEndomorphism::Monomials(int n, int k) {
+	if (n>64) throw OutOfRange(__FILE__,__LINE__,n);
+	if (k<0 || k>n) throw OutOfRange(__FILE__,__LINE__,k);
+	vector<uint64_t> result;
+	vector<int> indices(k);
+	for (int h=0;h<k;++h) indices[h]=h;
+	while (true) {
+		uint64_t mask=0;
+		for (int i: indices) mask|=uint64_t{1}<<i;
+		result.push_back(mask);
+		int h=k-1;
+		while (h>=0 && indices[h]==n-k+h) --h;
+		if (h<0) break;
+		++indices[h];
+		for (int l=h+1;l<k;++l) indices[l]=indices[l-1]+1;
+	}
+	return result;
+}
+
+SparseEndomorphism SparseEndomorphism::OnLambda(int k) const {
+	vector<uint64_t> monomials=Monomials(Dimension(),k);
+	unordered_map<uint64_t,ZeroBased> position;
+	for (int i=0;i<monomials.size();++i) position[monomials[i]]=i;
+	SparseEndomorphism result(monomials.size());
+	for (int j=0;j<monomials.size();++j)
+		for (auto& term: OnMonomial(monomials[j]))
+			result.Add(position[term.first],j,term.second);
+	return result;
+}
+
+SparseEndomorphism SparseEndomorphism::OnTensorProduct(const SparseEndomorphism& A, const SparseEndomorphism& B) {
+	int m=B.Dimension();
+	SparseEndomorphism result(A.Dimension()*m);
+	for (int i=0;i<A.Dimension();++i)
+	for (int j=0;j<m;++j) {
+		for (auto& entry: A[i])
+			result.Add(entry.first*m+j,i*m+j,entry.second);
+		for (auto& entry: B[j])
+			result.Add(i*m+entry.first,i*m+j,entry.second);
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *  Copyright (C) 2007-2023 by Diego Conti, diego.conti@unipi.it 
+ *  This file is part of Wedge.                                           
+ *  Wedge is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Wedge is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef ACTIONMATRIX_H_
+#define ACTIONMATRIX_H_
+/** @ingroup Representations */
+/** @{ 
+  * @file actionmatrix.h 
+  * @brief Sparse matrices representing the action of a Lie algebra on a representation and on the induced representations
+*/
+
+#include "wedge/linearalgebra/basis.h"
+
+namespace Wedge {
+using namespace GiNaC;
+using namespace std;
+
+/** @brief The matrix of an endomorphism of a vector space with respect to a basis \f$e_1,\dotsc,e_n\f$, stored as the list of nonzero entries in each column
+ *
+ * The endomorphism maps \f$e_j\f$ to \f$\sum_i a_{ij}e_i\f$. The induced endomorphisms of \f$\Lambda^k\f$ and tensor products are the derivations extending it, 
+ * i.e. the induced action of a Lie algebra.
+ */
+class SparseEndomorphism {
+public:
+	typedef vector<pair<ZeroBased,ex>> Column;	///< Pairs \f$(i,a_{ij})\f$ with \f$a_{ij}\f$ nonzero, for a fixed j
+	typedef vector<pair<uint64_t,ex>> Terms;	///< Pairs \f$(I,a_I)\f$ representing \f$\sum a_I e_I\f$, where multi-indices are represented by bitmasks
+	
+	SparseEndomorphism(int n=0) : columns(n) {}
+	int Dimension() const {return columns.size();}
+	const Column& operator[](ZeroBased j) const {return columns[j];}
+/** @brief Add a to the entry in position (i,j)
+ */
+	void Add(ZeroBased i, ZeroBased j, ex a);
+/** @brief Return a dense matrix representing this endomorphism
+ */
+	matrix AsMatrix() const;
+/** @brief Apply this endomorphism to a vector of components
+ */
+	exvector Apply(const exvector& v) const;
+/** @brief Apply the induced derivation to a monomial \f$e_I=e_{i_1}\wedge\dots\wedge e_{i_k}\f$, \f$i_1<\dots<i_k\f$
+ * @param I A bitmask representing the multi-index \f$i_1,\dotsc,i_k\f$
+ * @return The induced action on \f$e_I\f$, as a linear combination of monomials
+ * @throw OutOfRange if the dimension exceeds 64
+ */
+	Terms OnMonomial(uint64_t I) const;
+/** @brief The matrix of the induced derivation on \f$\Lambda^k\f$
+ * @param k An integer in the range [0,n]
+ * @return A SparseEndomorphism relative to the basis of monomials returned by Monomials(n,k)
+ */
+	SparseEndomorphism OnLambda(int k) const;
+/** @brief Return the monomials \f$e_{i_1}\wedge\dots\wedge e_{i_k}\f$, \f$i_1<\dots<i_k\f$, in lexicographic order, represented as bitmasks
+ */
+	static vector<uint64_t> Monomials(int n, int k);
+/** @brief The matrix of \f$A\otimes 1+1\otimes B\f$ on \f$V\otimes W\f$
+ * @return A SparseEndomorphism relative to the basis \f$e_i\otimes f_j\f$ of \f$V\otimes W\f$, where \f$e_i\otimes f_j\f$ is the element in position i*B.Dimension()+j 
+ */
+	static SparseEndomorphism OnTensorProduct(const SparseEndomorphism& A, const SparseEndomorphism& B);
+private:
+	vector<Column> columns;
+};
+
+/** @brief The matrices representing the action of elements of a Lie algebra on a fixed basis of a representation of type T
+ * 
+ * Each matrix is computed the first time it is requested, and then stored.
+ */
+template<typename T> class ActionMatrices {
+	ExVector e;
+	Basis<T> basis;
+	mutable map<ex,SparseEndomorphism,ex_is_less> matrices;
+public:
+	ActionMatrices(const ExVector& e) : e{e}, basis{e} {}
+/** @brief The basis of the representation the matrices refer to
+ */
+	const ExVector& BaseSpace() const {return e;}
+/** @brief Return the matrix representing an element of the Lie algebra
+ * @param A An element of the Lie algebra
+ * @param action A function such that action(A,v) gives the action of A on a vector v of type T
+ */
+	template<typename Action> const SparseEndomorphism& Get(ex A, Action&& action) const {
+		auto i=matrices.find(A);
+		if (i!=matrices.end()) return i->second;
+		SparseEndomorphism result(e.size());
+		for (int j=1;j<=e.size();++j) {
+			ExVector comps=basis.Components(action(A,e(j)));
+			for (int i=1;i<=comps.size();++i)
+				if (!comps(i).is_zero()) result.Add(i-1,j-1,comps(i));
+		}
+		return matrices.emplace(A,std::move(result)).first->second;
+	}
+};
+
+} /** @} */
+#endif /*ACTIONMATRIX_H_*/
@@ -26,6 +26,7 @@
 */
 
 #include "wedge/representations/linearaction.h"
+#include "wedge/representations/actionmatrix.h"
 #include "wedge/liealgebras/liegroup.h"
 namespace Wedge {
 
@@ -34,6 +35,7 @@ namespace Wedge {
 class AdjointRepresentation {
 	const LieGroup* G;
 	lst subs;	//the substitutions mapping an element of so(n) to the corresponding LinearAction object
+	ActionMatrices<VectorField> matrices;
 public:
 	typedef VectorField ActsOnType;
 
@@ -42,7 +44,7 @@ public:
  *
  * @warning Caller must ensure that the pointer G remains valid.
 */
-	AdjointRepresentation(const LieGroup* G) {
+	AdjointRepresentation(const LieGroup* G) : matrices(G->e()) {
 		this->G=G;
 	}
 /** @brief Action of an element of \f$\mathfrak{g}\f$ on a vector
@@ -59,6 +61,16 @@ public:
 		LinearAction<VectorField> a(G->e(),ei_goes_to);
 		return AlgebraAction<VectorField,R>(a,v);
 	}
+/** @brief The matrix of the action of an element of \f$\mathfrak{g}\f$ on the basis of \f$\mathfrak{g}\f$
+ * @param A An element of \f$\mathfrak{g}\f$
+ * @return A SparseEndomorphism relative to the basis BaseSpace(); it is computed once for each A and then stored
+ */
+	const SparseEndomorphism& ActionMatrix(ex A) const {
+		return matrices.Get(A,[this] (ex A, ex v) {return Action<VectorField>(A,v);});
+	}
+/** @brief The basis of \f$\mathfrak{g}\f$ used by ActionMatrix, i.e. G->e()
+ */
+	const ExVector& BaseSpace() const {return matrices.BaseSpace();}
 /** @brief Computes the conditions on a generic element in the representation, for the algebra to act trivially on it.
  * @param container A container where the equation are to be stored
  * @param v A (generic) element of a representation of \f$\mathfrak{g}\f$
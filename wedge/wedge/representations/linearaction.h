@@ -55,6 +55,15 @@ public:
 		const LinearActionBase& o =static_cast<const LinearActionBase&>(other);
 		return linear_subs.compare(o.linear_subs);
 	}
+	void archive(archive_node& n) const override {
+		RegClass::archive(n);
+		n.add_ex("subs",linear_subs);
+	}
+	void read_archive(const archive_node& n, lst& sym_lst) override {
+		RegClass::read_archive(n,sym_lst);
+		ex subs;
+		if (n.find_ex("subs",subs,sym_lst)) linear_subs=ex_to<lst>(subs);
+	}
 protected:
 	lst linear_subs;
 	ex eval_ncmul(const exvector & v) const; ///< Implements the composition of endomorphisms
@@ -27,6 +27,7 @@
 
 #include "../liealgebras/so.h"
 #include "wedge/representations/linearaction.h"
+#include "wedge/representations/actionmatrix.h"
 
 namespace Wedge {
 
@@ -36,6 +37,7 @@ template<typename T>  class SORepresentation {
 	const SO* G;
 	ExVector e;
 	lst subs;	//the substitutions mapping an element of so(n) to the corresponding LinearAction object
+	ActionMatrices<T> matrices;
 public:	
 	typedef T ActsOnType;
 
@@ -45,7 +47,7 @@ public:
  *
  * @warning Caller must ensure that the pointer G remains valid.
 */
-	SORepresentation(const SO* G, const ExVector& frame) : e(frame) {
+	SORepresentation(const SO* G, const ExVector& frame) : e(frame), matrices(frame) {
 		this->G=G;
 		assert(e.size()==G->n());
 
@@ -68,6 +70,16 @@ public:
 		LinearAction<T> a(e,eigoesto);
 		return AlgebraAction<T,R>(a,v);
 	}
+/** @brief The matrix of the action of an element of \f$\mathfrak{so}(n)\f$ on the basis of \f$\mathbb{R}^n\f$
+ * @param A An element of \f$\mathfrak{so}(n)\f$
+ * @return A SparseEndomorphism relative to the basis BaseSpace(); it is computed once for each A and then stored
+ */
+	const SparseEndomorphism& ActionMatrix(ex A) const {
+		return matrices.Get(A,[this] (ex A, ex v) {return this->template Action<T>(A,v);});
+	}
+/** @brief The basis of \f$\mathbb{R}^n\f$ specified on construction
+ */
+	const ExVector& BaseSpace() const {return matrices.BaseSpace();}
 /** @brief Computes the conditions on a generic element in the representation, for the algebra to act trivially on it.
  * @param container A container where the equation are to be stored
  * @param v A (generic) element of a representation of \f$\mathfrak{so}(n)\f$
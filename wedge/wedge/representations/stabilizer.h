@@ -21,6 +21,9 @@
 #define STABILIZER_H_
 
 #include "wedge/representations/linearaction.h"
+#include "wedge/representations/actionmatrix.h"
+#include "wedge/linearalgebra/bilinearform.h"
+#include "wedge/linearalgebra/sparselinearsystem.h"
 namespace Wedge {
 
 /** @ingroup Representations
@@ -29,7 +32,74 @@ namespace Wedge {
   * @brief Stabilizers of Lie algebra actions
 */
 
+namespace internal {
+
+/** @internal @brief Compute the action of a list of Lie algebra elements on an element of \f$R\f$ through the matrices returned by Representation::ActionMatrix
+ * @param images On return, the i-th element lists the nonzero components of the image of v under generators[i], relative to the monomials in the basis BaseSpace()
+ * @return false if R is neither the representation nor its exterior algebra, or v cannot be written in terms of the basis BaseSpace(); in this case, images is left in an unspecified state
+ */
+template<typename R, typename Representation> 
+bool ActionOnMonomials(const Representation& representation, const exvector& generators, ex v, vector<map<uint64_t,ex>>& images)
+{
+	using T=typename Representation::ActsOnType;
+	if constexpr (is_same<R,T>::value || is_same<R,Lambda<T>>::value) {
+		Frame frame(representation.BaseSpace());
+		if (frame.size()>64 || !FrameMonomials::Supports(frame)) return false;	//SparseEndomorphism::OnMonomial takes a single word
+		FrameMonomials monomials(frame);
+		FrameMonomials::Terms terms;
+		if (!monomials.Decompose(v,terms)) return false;
+		images.clear();
+		for (ex X: generators) {
+			const SparseEndomorphism& A=representation.ActionMatrix(X);
+			map<uint64_t,ex> image;
+			for (auto& term: terms)
+				for (auto& image_term: A.OnMonomial(term.first.Bits()))
+					image[image_term.first]+=term.second*image_term.second;
+			for (auto i=image.begin();i!=image.end();)
+				if ((i->second=i->second.expand()).is_zero()) i=image.erase(i);
+				else ++i;
+			images.push_back(std::move(image));
+		}
+		return true;
+	}
+	else return false;
+}
+
+/** @internal @brief Arrange the images computed by ActionOnMonomials as the columns of a matrix, whose rows correspond to the monomials that appear
+ */
+inline matrix ImagesAsMatrix(const vector<map<uint64_t,ex>>& images) {
+	map<uint64_t,int> rows;
+	for (auto& image: images)
+		for (auto& term: image) rows.emplace(term.first,0);
+	int row=0;
+	for (auto& x: rows) x.second=row++;
+	matrix result(rows.size(),images.size());
+	for (int j=0;j<images.size();++j)
+		for (auto& term: images[j])
+			result(rows[term.first],j)=term.second;
+	return result;
+}
+
+/** @internal @brief Turn the images computed by ActionOnMonomials into a linear system, whose unknowns are the coefficients of the generators
+ * @return false if some coefficient is not rational
+ */
+inline bool ImagesAsLinearSystem(const vector<map<uint64_t,ex>>& images, SparseLinearSystem& system) {
+	map<uint64_t,SparseLinearSystem::Row> rows;
+	for (int j=0;j<images.size();++j)
+		for (auto& term: images[j]) {
+			if (!SparseLinearSystem::IsCoefficient(term.second)) return false;
+			rows[term.first][j]=ex_to<numeric>(term.second);
+		}
+	for (auto& row: rows) system.AddEquation(std::move(row.second));
+	return true;
+}
+
+}
+
 /** @brief Return the dimension of the \f$G\f$-orbit of an element in a representation \f$R\f$
+ *
+ * If \f$R\f$ is the representation or its exterior algebra, the matrices returned by Representation::ActionMatrix are used to reduce the problem to the rank of a matrix 
+ * whose rows are indexed by the monomials that appear in the orbit.
  * @param G The object representing the Lie group
  * @param representation The representation inducing the representation \f$R\f$
  * @param v An element in the representation \f$R\f$
@@ -39,6 +109,13 @@ namespace Wedge {
    template<typename R, typename Representation> 
 int OrbitDimension(const LieGroupWithoutParameters& G,const Representation& representation, ex v)
 {
+	vector<map<uint64_t,ex>> images;
+	if (internal::ActionOnMonomials<R>(representation,G.e(),v,images)) {
+		SparseLinearSystem system(images.size());
+		if (internal::ImagesAsLinearSystem(images,system)) return system.Rank();
+		matrix A=internal::ImagesAsMatrix(images);
+		return A.rows()? A.rank() : 0;
+	}
 	exvector image;
 	for (exvector::const_iterator i=G.e().begin();i!=G.e().end();++i)
 		image.push_back(representation.template Action<R>(*i,v));
@@ -47,6 +124,9 @@ int OrbitDimension(const LieGroupWithoutParameters& G,const Representation& repr
 }
 
 /** @brief Return the Lie algebra of the stabilizer of an element in a representation \f$R\f$ with respect to the action of a group \f$G\f$
+ *
+ * If \f$R\f$ is the representation or its exterior algebra, the linear equations are obtained from the matrices returned by Representation::ActionMatrix,
+ * and solved by a SparseLinearSystem when their coefficients are rational.
  * @param G The object representing the Lie group
  * @param representation The representation inducing the representation \f$R\f$
  * @param v An element in the representation \f$R\f$
@@ -57,9 +137,30 @@ int OrbitDimension(const LieGroupWithoutParameters& G,const Representation& repr
 Subspace<DifferentialForm > StabilizerAlgebra(const LieGroupWithoutParameters& G,const Representation& representation, ex v)
 {
 	VectorSpace<DifferentialForm> V=G.pForms(1);
-	ex image=representation.template Action<R>(V.GenericElement(),v);
 	list<ex> eqns;
-	GetCoefficients<DifferentialForm>(eqns,image);
+	vector<map<uint64_t,ex>> images;
+	if (internal::ActionOnMonomials<R>(representation,V.e(),v,images)) {
+		SparseLinearSystem system(images.size());
+		if (internal::ImagesAsLinearSystem(images,system)) {
+			exvector generators;
+			for (auto& solution: system.Solutions()) {
+				ex generator;
+				for (int j=0;j<solution.size();++j) generator+=solution[j]*V.e()[j];
+				generators.push_back(generator);
+			}
+			return V.Subspace(generators.begin(),generators.end());
+		}
+		matrix A=internal::ImagesAsMatrix(images);
+		for (int i=0;i<A.rows();++i) {
+			ex eqn;
+			for (int j=0;j<A.cols();++j) eqn+=A(i,j)*V.coordinate(j+1);
+			eqns.push_back(eqn);
+		}
+	}
+	else {
+		ex image=representation.template Action<R>(V.GenericElement(),v);
+		GetCoefficients<DifferentialForm>(eqns,image);
+	}
 	return V.SubspaceFromEquations(eqns.begin(),eqns.end());
 }
 
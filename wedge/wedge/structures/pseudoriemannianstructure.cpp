@@ -19,6 +19,7 @@
  *******************************************************************************/
 #include "../structures/pseudoriemannianstructure.h"
 #include "pseudoriemannianstructure.h"
+#include "wedge/base/normalform.h"
 
 namespace Wedge {
 
@@ -67,13 +68,34 @@ class CliffordProduct : public IBilinearOperator<LinearOperator<VectorField>,Lin
 	ExVector taus;	//tau_k=i if e_k is timelike and 1 if spacelike
 	int s;	//the second element of the signature (r,s), i..e the number of taus that equal i
 
+public:
+	//the action of an element of the Clifford algebra on the basis of spinors, i.e. u \mapsto (-1)^{parity(sign)} phase u.flip(flip)
+	struct SignedPermutation {
+		uint64_t flip;	//the signs inverted by the Clifford product
+		uint64_t sign;	//the signs whose product contributes to the coefficient
+		ex phase;	//the constant part of the coefficient
+
+		//the composition of a and b, i.e. u\mapsto a(b(u))
+		static SignedPermutation Compose(const SignedPermutation& a, const SignedPermutation& b) {
+			ex phase=a.phase*b.phase;
+			if (__builtin_popcountll(b.flip&a.sign)%2) phase=-phase;
+			return {a.flip^b.flip,a.sign^b.sign,phase};
+		}
+	};
+private:
+	vector<SignedPermutation> table;	//the j-th element represents the action of e_{j+1}
+	mutable map<ex,OneBased,ex_is_less> frame_vectors;	//the index j of each e_j, filled in on first use; other vector fields are not cached, so that memory does not grow with the vector fields encountered
+
 	virtual ex alpha_j(OneBased j) const=0;
 
-	ex dot(OneBased j, const Spinor& spinor) const {
-		ex coeff=taus(j)*spinor.product_up_to(j/2)*alpha_j(j);
-		if (((j-1)/2)%2) coeff=-coeff;
-		if (j==taus.size() && j%2==1)  return coeff*spinor;
-		else return coeff*spinor.reflect((j+1)/2);
+	void InitializeTable() {
+		table.reserve(n());
+		for (int j=1;j<=n();++j) {
+			ex phase=taus(j)*alpha_j(j);
+			if (((j-1)/2)%2) phase=-phase;
+			uint64_t flip= (j==n() && j%2==1)? 0 : uint64_t{1}<<((j-1)/2);
+			table.push_back({flip,Spinor::LowBits(j/2),phase});
+		}
 	}
 	CliffordProduct(const Frame& coframe, const ExVector& taus, int s) : coframe{coframe}, taus{taus},s{s}{}
 	static CliffordProduct* Create(const Frame& coframe,  const ExVector& taus, int s,CliffordConvention clifford_convention);
@@ -92,13 +114,23 @@ public:
 			if (square_norms_of_frame_vectors[i]<0) ++s;		}
 		return Create(coframe, taus,s,clifford_convention);
 	}
+	const SignedPermutation& OnFrameVector(OneBased j) const {return table[j-1];}
+	ex dot(OneBased j, const Spinor& spinor) const {
+		auto& e_j=table[j-1];
+		return (spinor.parity(e_j.sign)? -e_j.phase : e_j.phase)*spinor.flip(e_j.flip);
+	}
 	ex Apply (const VectorField& X, const Spinor& spinor) const
 	{
-		ex result;		
-		for (int i=1;i<=coframe.size();++i) {
-			ex component = TrivialPairing<VectorField>(X,coframe(i));			
-			if (!component.is_zero())
-				result+=component*dot(i,spinor);
+		if (frame_vectors.empty()) {
+			const ExVector& dual=coframe.dual();	//computed only once, since it may involve inverting a matrix
+			for (int j=1;j<=n();++j) frame_vectors.emplace(dual(j),j);
+		}
+		auto i=frame_vectors.find(X);
+		if (i!=frame_vectors.end()) return dot(i->second,spinor);
+		ex result;
+		for (int j=1;j<=coframe.size();++j) {
+			ex component = TrivialPairing<VectorField>(X,coframe(j));
+			if (!component.is_zero()) result+=component*dot(j,spinor);
 		}
 		return result;
 	}
@@ -106,6 +138,16 @@ public:
 	int n() const {return taus.size();}
 };
 
+//applies the Clifford product by a fixed element of the frame to a linear combination of spinors
+class CliffordProductByFrameVector : public LinearOperator<Spinor> {
+	const CliffordProduct& clifford;
+	OneBased j;
+public:
+	CliffordProductByFrameVector(const CliffordProduct& clifford, OneBased j) : clifford{clifford}, j{j} {}
+	void visit(const Spinor& psi) {
+		Result()=clifford.dot(j,psi);
+	}
+};
 
 class BaumKathCliffordProduct : public CliffordProduct {
 	using CliffordProduct::CliffordProduct;
@@ -130,26 +172,89 @@ public:
 };
 		
 CliffordProduct* CliffordProduct::Create(const Frame& coframe,  const ExVector& taus, int s,CliffordConvention clifford_convention) {
+	CliffordProduct* result=nullptr;
 	switch (clifford_convention) {
-		case CliffordConvention::BAUM_KATH: return new BaumKathCliffordProduct(coframe, taus,s);
-		case CliffordConvention::STANDARD:  return new StandardCliffordProduct(coframe, taus,s);
+		case CliffordConvention::BAUM_KATH: result=new BaumKathCliffordProduct(coframe, taus,s); break;
+		case CliffordConvention::STANDARD:  result=new StandardCliffordProduct(coframe, taus,s); break;
+	}
+	if (result) {
+		result->InitializeTable();
+		return result;
 	}
 	throw WedgeException<logic_error>("Unexpected value in CliffordConvention object",__FILE__,__LINE__);
 }
 
 
 class CliffordProductForm : public IBilinearOperator<AssociativeOperator<DifferentialForm>,LinearOperator<Spinor>> {
+	using SignedPermutation=CliffordProduct::SignedPermutation;
 	const CliffordProduct& clifford;
 	const PseudoRiemannianStructure& g;
+	mutable map<ex,ex,ex_is_less> sharp;	//the vector fields corresponding to the elements of the coframe, filled in on first use
+
+	//tables are filled in lazily, because the scalar product is not available on construction
+	mutable bool initialized=false;
+	mutable unique_ptr<internal::FrameMonomials> monomials;	//null if the tables cannot be used, i.e. the coframe is not made of simple one-forms, or (e^j)^\sharp is not a multiple of e_j
+	mutable vector<SignedPermutation> sharp_table;	//the j-th element represents the action of (e^{j+1})^\sharp
+	mutable unordered_map<internal::FrameMask,SignedPermutation,internal::FrameMaskHash> monomial_table;	//the action of the monomials e^I encountered so far
+
+	const internal::FrameMonomials* Monomials() const {
+		if (initialized) return monomials.get();
+		initialized=true;
+		const Frame& coframe=g.e();
+		if (!internal::FrameMonomials::Supports(coframe)) return nullptr;
+		for (int j=1;j<=coframe.size();++j) {
+			ex X=g.ScalarProduct().Sharp(coframe(j));
+			ex c=TrivialPairing<VectorField>(X,coframe(j));
+			if (c.is_zero() || !(X-c*coframe.dual()(j)).expand().is_zero()) {
+				sharp_table.clear();
+				return nullptr;
+			}
+			auto e_j=clifford.OnFrameVector(j);
+			sharp_table.push_back({e_j.flip,e_j.sign,c*e_j.phase});
+		}
+		monomials.reset(new internal::FrameMonomials{coframe});
+		return monomials.get();
+	}
+	const SignedPermutation& OnMonomial(const internal::FrameMask& mask) const {
+		auto i=monomial_table.find(mask);
+		if (i!=monomial_table.end()) return i->second;
+		//e^{i_1}\wedge\dots\wedge e^{i_k} acts as e^{i_1}\cdot(\dots (e^{i_k}\cdot \psi)), where the e^{i_h} are orthogonal
+		SignedPermutation result{0,0,1};
+		for (int j=0;j<sharp_table.size();++j)
+			if (mask.Contains(j)) result=SignedPermutation::Compose(result,sharp_table[j]);
+		return monomial_table.emplace(mask,result).first->second;
+	}
 public:
 	CliffordProductForm(const CliffordProduct& clifford, const PseudoRiemannianStructure& g) : clifford{clifford}, g{g} {}
 	ex Apply (const VectorField& alpha, const Spinor& psi) const {
-		auto X=g.ScalarProduct().Sharp(alpha);
-		return CliffordProduct::BilinearOperator(X,psi,&clifford);
+		if (sharp.empty())
+			for (auto& e_j: g.e()) sharp.emplace(e_j,g.ScalarProduct().Sharp(e_j));
+		auto i=sharp.find(alpha);
+		return CliffordProduct::BilinearOperator(i!=sharp.end()? i->second : g.ScalarProduct().Sharp(alpha),psi,&clifford);
+	}
+/* Write a form as a combination of monomials e^I, and compute the signed permutations by which they act on spinors; return false if
+ * alpha has a scalar part or the tables cannot be used
+ */
+	bool Decompose(ex alpha, vector<pair<const SignedPermutation*,ex>>& terms) const {
+		auto frame_monomials=Monomials();
+		internal::FrameMonomials::Terms monomial_terms;
+		if (!frame_monomials || !frame_monomials->Decompose(alpha,monomial_terms)) return false;
+		for (auto& term: monomial_terms)
+			terms.emplace_back(&OnMonomial(term.first),term.second);
+		return true;
+	}
+/* Write a spinor as a linear combination of basis spinors; return false if it contains anything else */
+	static bool Decompose(ex psi, vector<pair<Spinor,ex>>& terms) {
+		LambdaVectorNormalForm normal_form(psi);
+		if (!normal_form.scalar_part.is_zero() || normal_form.lambda_vector_part.begin()!=normal_form.lambda_vector_part.end()) return false;
+		for (auto& term: normal_form.vector_part) {
+			if (!is_a<Spinor>(term.first)) return false;
+			terms.emplace_back(ex_to<Spinor>(term.first),term.second);
+		}
+		return true;
 	}
 };
 
-
 PseudoRiemannianStructureByFrame::PseudoRiemannianStructureByFrame(const Manifold *manifold, const Frame &frame, CliffordProduct *clifford_product)
 	: PseudoRiemannianStructure(manifold,frame), clifford_product_operator{clifford_product}, clifford_product_form_operator{new CliffordProductForm(*clifford_product_operator,*this)} {}
 
@@ -164,7 +269,48 @@ ex PseudoRiemannianStructureByFrame::CliffordDot(ex X, ex psi) const {
 	return CliffordProduct::BilinearOperator(X,psi,clifford_product_operator.get());
 }
 ex PseudoRiemannianStructureByFrame::CliffordDotByForm(ex alpha, ex psi) const {
-	return CliffordProductForm::BilinearOperator(alpha,psi,clifford_product_form_operator.get());
+	vector<pair<const CliffordProduct::SignedPermutation*,ex>> monomials;
+	vector<pair<Spinor,ex>> spinors;
+	if (!clifford_product_form_operator->Decompose(alpha,monomials) || !CliffordProductForm::Decompose(psi,spinors))
+		return CliffordProductForm::BilinearOperator(alpha,psi,clifford_product_form_operator.get());
+	exmap result;
+	for (auto& monomial: monomials)
+	for (auto& spinor: spinors) {
+		auto& action=*monomial.first;
+		ex coeff=action.phase*monomial.second*spinor.second;
+		result[spinor.first.flip(action.flip)]+=spinor.first.parity(action.sign)? -coeff : coeff;
+	}
+	ex sum;
+	for (auto& x: result) sum+=x.second*x.first;
+	return sum;
+}
+
+matrix PseudoRiemannianStructureByFrame::CliffordDotAsMatrix(ex alpha) const {
+	int N=DimensionOfSpinorRepresentation();
+	matrix result(N,N);
+	vector<pair<const CliffordProduct::SignedPermutation*,ex>> monomials;
+	if (clifford_product_form_operator->Decompose(alpha,monomials)) {
+		for (auto& monomial: monomials) {
+			auto& action=*monomial.first;
+			ex coeff=action.phase*monomial.second;
+			for (int h=0;h<N;++h) {
+				Spinor u_h=ex_to<Spinor>(u(h));
+				result(h^action.flip,h)+=u_h.parity(action.sign)? -coeff : coeff;
+			}
+		}
+	}
+	else for (int h=0;h<N;++h) {
+		vector<pair<Spinor,ex>> spinors;
+		if (!CliffordProductForm::Decompose(CliffordDotByForm(alpha,u(h)),spinors)) throw InvalidArgument(__FILE__,__LINE__,alpha);
+		for (auto& spinor: spinors)
+			result(spinor.first.bits(),h)+=spinor.second;
+	}
+	return result;
+}
+ex PseudoRiemannianStructureByFrame::CliffordDotByFrameVector(OneBased j, ex psi) const {
+	if (j<1 || j>e().size()) throw OutOfRange(__FILE__,__LINE__,j);
+	CliffordProductByFrameVector v(*clifford_product_operator,j);
+	return v.RecursiveVisit(psi);
 }
 
 PseudoRiemannianStructureByOrthonormalFrame::PseudoRiemannianStructureByOrthonormalFrame(const Manifold* manifold, const Frame& frame, ScalarProductByOrthonormalFrame&& scalar_product, CliffordConvention clifford_convention) :
@@ -188,6 +188,23 @@ public:
  * @return The spinor \f$ alpha\cdot\psi\f$.
 */
 	ex CliffordDotByForm(ex alpha, ex psi) const;
+
+/** @brief Compute the Clifford action of an element of the frame on a spinor
+ * @param j An index in the range [1,n]
+ * @param psi A spinor
+ * @return The spinor \f$ e_j\cdot\psi\f$, where \f$e_1,\dotsc,e_n\f$ is the frame dual to e()
+ *
+ * This is equivalent to CliffordDot(e().dual()(j),psi), but it does not need to decompose the vector field; each basis spinor is mapped to a multiple of another basis spinor by a precomputed table.
+*/
+	ex CliffordDotByFrameVector(OneBased j, ex psi) const;
+
+/** @brief Compute the matrix representing the Clifford action of a form on spinors
+ * @param alpha A differential form
+ * @return The matrix whose (k,h) entry is the coefficient of u(k) in \f$ alpha\cdot u(h)\f$
+ *
+ * If the coframe is made of simple one-forms, each basis k-form acts on the basis of spinors by a signed permutation, which is composed from the actions of the frame vectors when first needed and then stored; CliffordDotByForm uses the same tables.
+*/
+	matrix CliffordDotAsMatrix(ex alpha) const;
 /**
    @brief Returns the rank of the complex spinor bundle
    @return The number \f$2^{[n/2]}\f$, where \f$n\f$ is the manifold's dimension
@@ -37,6 +37,38 @@ void RiemannianStructure::Deleter::operator()(RiemannianHookOperator* r) {
 	delete r;
 }
 
+/* When the elements of the orthonormal frame are simple one-forms, every form is a combination of monomials e^I, indexed by bitmasks I, and
+ * e^I\hook e^J is zero unless I is contained in J, in which case it is plus or minus e^{J-I}. The nonzero values are computed once on monomials and stored.
+ */
+class RiemannianStructure::MonomialTables : public internal::FrameMonomials {
+	unordered_map<pair<internal::FrameMask,internal::FrameMask>,ex,internal::MaskPairHash> hooks;
+public:
+	using FrameMonomials::FrameMonomials;
+	ex Hook(const internal::FrameMask& I, const internal::FrameMask& J, const RiemannianStructure& structure) {
+		if (!I.IsSubsetOf(J)) return 0;
+		auto key=make_pair(I,J);
+		auto it=hooks.find(key);
+		if (it!=hooks.end()) return it->second;
+		return hooks[key]=structure.SlowHook(Monomial(I),Monomial(J));
+	}
+};
+
+void RiemannianStructure::Deleter::operator()(MonomialTables* t) {
+	delete t;
+}
+
+RiemannianStructure::MonomialTables* RiemannianStructure::Tables() const
+{
+	if (!tables || !tables->RefersTo(e())) {
+		if (!MonomialTables::Supports(e())) {
+			tables.reset();
+			return nullptr;
+		}
+		tables.reset(new MonomialTables(e()));
+	}
+	return tables.get();
+}
+
 RiemannianStructure::RiemannianStructure(const Manifold* manifold, const Frame& orthonormal_frame,CliffordConvention clifford_convention) : 		
 	PseudoRiemannianStructureByOrthonormalFrame{manifold, orthonormal_frame, ScalarProductByOrthonormalFrame::FromTimelikeIndices(orthonormal_frame,{}),clifford_convention},
 	hookOperator{new RiemannianHookOperator(this)}
@@ -44,6 +76,15 @@ RiemannianStructure::RiemannianStructure(const Manifold* manifold, const Frame&
 
 ex RiemannianStructure::HodgeStar(ex form1) const
 {
+	MonomialTables* t=Tables();
+	MonomialTables::Terms terms;
+	if (t && t->Decompose(form1,terms) && MonomialTables::IsHomogeneous(terms)) {
+		ex result;
+		internal::FrameMask full=t->Full();
+		for (auto& term: terms)
+			result+=term.second*t->Hook(term.first,full,*this);
+		return result.expand();
+	}
 	ex form=e()[0];
 	for (int i=1;i<e().size();i++)
 		form*=e()[i];
@@ -51,6 +92,20 @@ ex RiemannianStructure::HodgeStar(ex form1) const
 }
 
 ex RiemannianStructure::Hook(ex left, ex right) const
+{
+	MonomialTables* t=Tables();
+	MonomialTables::Terms left_terms, right_terms;
+	if (t && t->Decompose(left,left_terms) && t->Decompose(right,right_terms) && MonomialTables::IsHomogeneous(left_terms)) {
+		ex result;
+		for (auto& x: left_terms)
+		for (auto& y: right_terms)
+			if (x.first.IsSubsetOf(y.first)) result+=x.second*y.second*t->Hook(x.first,y.first,*this);
+		return result.expand();
+	}
+	return SlowHook(left,right);
+}
+
+ex RiemannianStructure::SlowHook(ex left, ex right) const
 {
 	ex result=RiemannianHookOperator::BilinearOperator(left.expand(),right.expand(),hookOperator.get()).expand();
 		//adjust sign so that e^{12..n}\hook e^{12..n}=1
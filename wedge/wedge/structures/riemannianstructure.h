@@ -85,10 +85,16 @@ public:
  	
 private:
 	class RiemannianHookOperator;
+	class MonomialTables;
 	struct Deleter {
   		void operator()(RiemannianHookOperator* r);    
+  		void operator()(MonomialTables* t);
 	};
  	unique_ptr<RiemannianHookOperator,Deleter> hookOperator;
+	mutable unique_ptr<MonomialTables,Deleter> tables;	///< Interior products of monomials in the frame, filled in lazily
+
+	MonomialTables* Tables() const;	///< Return the tables for the current frame, or nullptr if the frame does not consist of simple one-forms
+	ex SlowHook(ex alpha, ex beta) const;
 };
 
 template<> ex RiemannianStructure::ScalarProduct<VectorField> (ex op1, ex op2) const;
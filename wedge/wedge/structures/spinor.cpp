@@ -23,35 +23,45 @@
 
 namespace Wedge {
 
-Spinor::Spinor(vector<bool> index)
-{
-	this->a=index;
-}
-
 int Spinor::compare_same_type(const basic &other) const
 {
 	const Spinor &o = static_cast<const Spinor &>(other);
 //it is assumed that spinors appearing in the same expression belong to the same manifold. Here, we only check that the dimensions are consistent.
-	assert(a.size()==o.a.size());
-	for (int i=a.size()-1;i>=0;i--)
-		if (a[i] && !o.a[i]) return 1;
-		else if (o.a[i] && !a[i]) return -1;
+	assert(m==o.m);
+	if (index<o.index) return -1;
+	else if (index>o.index) return 1;
 	return 0;
 }
 
 void Spinor::print(const print_context &c, unsigned level) const {
-	int index=0;
-	for (auto i=a.rbegin();i!=a.rend();i++) index=*i? index*2+1:index*2;
 	if (dynamic_cast<const GiNaC::print_latex*>(&c))
 		c.s<<"u_{"<<index<<"}";
 	else
 		c.s<<"u"<<index;
 }
 
+void Spinor::archive(archive_node& n) const {
+	RegClass::archive(n);
+	for (int i=0;i<m;++i) n.add_bool("epsilon",(index>>i)&1);
+}
+
+void Spinor::read_archive(const archive_node& n, lst& sym_lst) {
+	RegClass::read_archive(n,sym_lst);
+	index=0;
+	m=0;
+	bool epsilon;
+	for (;n.find_bool("epsilon",epsilon,m);++m) {
+		if (m==MaxLength) throw OutOfRange(__FILE__,__LINE__,m);
+		if (epsilon) index|=uint64_t{1}<<m;
+	}
+}
+
 Spinor Spinor::from_epsilons(const vector<int>& signs) {
-	vector<bool> as_bools;
-	transform(signs.begin(),signs.end(), back_inserter(as_bools), [] (int x) {return x<0;});
-	return Spinor{as_bools};
+	if (signs.size()>MaxLength) throw OutOfRange(__FILE__,__LINE__,static_cast<int>(signs.size()));
+	uint64_t index=0;
+	for (int i=0;i<signs.size();++i)
+		if (signs[i]<0) index|=uint64_t{1}<<i;
+	return Spinor{index,static_cast<int>(signs.size())};
 }
 
 /**
@@ -61,15 +71,10 @@ Spinor Spinor::from_epsilons(const vector<int>& signs) {
    @return The spinor \f$ u(\epsilon_m,\dots,\epsilon_1)\f$ where m=[dimension/2] and \epsilon_i=1 if the i-th least significant digit in base 2 of n is 0 and -1 otherwise
 */
 Spinor Spinor::from_index_and_dimension(ZeroBased n, int dimension) {
-	auto oldn=n;
 	int m=dimension/2;
-	if (n<0) throw OutOfRange(__FILE__,__LINE__,n);
-	vector<int> signs;
-	signs.reserve(m);
-	for (int i=0;i<m;++i, n/=2)
-		signs.push_back((n%2)? -1 : 1);
-	if (n!=0) throw OutOfRange(__FILE__,__LINE__,oldn);
-	return Spinor::from_epsilons(signs);
+	if (m>MaxLength) throw OutOfRange(__FILE__,__LINE__,dimension);
+	if (n<0 || (m<MaxLength && static_cast<uint64_t>(n)>>m)) throw OutOfRange(__FILE__,__LINE__,n);
+	return Spinor{static_cast<uint64_t>(n),m};
 }
 
 }
@@ -44,8 +44,10 @@ using namespace std;
  */
 class Spinor : public Register<Spinor,Vector>::Algebraic
 {	
-	Spinor(vector<bool> index);
+	Spinor(uint64_t index, int m) : index{index}, m{m} {}
 public:
+	static constexpr int MaxLength=64;	///< The maximum number m of signs, i.e. spinors are supported up to dimension 2*MaxLength+1
+
 	int compare_same_type(const basic &other) const;	
 	Spinor()=default;
 
@@ -68,25 +70,54 @@ public:
 
 	unsigned return_type() const {return return_types::commutative;}
 	static const char* static_class_name() {return "Spinor";}
+	void archive(archive_node& n) const override;	///< Overloaded from basic::archive
+	void read_archive(const archive_node& n, lst& sym_lst) override;	///< Overloaded from basic::read_archive
 /** @brief Invert an index
  * @param j an index in the interval [1,m]
  *  @return the spinor u(\epsilon_m,... , -\epsilon_j, ..., \epsilon_1)
  */
 	Spinor reflect(OneBased j) const {
-		vector<bool> reversed=a;
-		reversed[j-1]=!reversed[j-1];
-		return Spinor{reversed};
+		return flip(uint64_t{1}<<(j-1));
 	}
 /** @brief Return the product of the first j signs
- * @param j an index in the interval [1,m]
+ * @param j an index in the interval [0,m]
  *  @return the product \epsilon_1,..., \epsilon_j
  */
 	int product_up_to(OneBased j) const {
-		 return std::count(a.begin(),a.begin()+j,true)%2==0? 1: -1;
+		 return parity(LowBits(j))? -1: 1;
+	}
+/** @brief Return the index of this spinor in the global basis, i.e. the integer whose binary digits encode the signs, as in from_index_and_dimension */
+	uint64_t bits() const {return index;}
+/** @brief Invert several indices at once
+ * @param mask a bitmask whose i-th least significant bit is set if \epsilon_{i+1} is to be inverted
+ *  @return the spinor obtained by inverting the signs indicated by mask
+ */
+	Spinor flip(uint64_t mask) const {
+		return Spinor{index^mask,m};
+	}
+/** @brief Determine the sign of a product of signs
+ * @param mask a bitmask whose i-th least significant bit is set if \epsilon_{i+1} appears in the product
+ *  @return true if the product of the signs indicated by mask equals -1
+ */
+	bool parity(uint64_t mask) const {
+		return __builtin_popcountll(index&mask)%2;
+	}
+/** @brief Return a bitmask selecting the first j signs
+ * @param j an index in the interval [0,MaxLength]
+ */
+	static uint64_t LowBits(int j) {
+		return j<MaxLength? (uint64_t{1}<<j)-1 : ~uint64_t{0};
+	}
+protected:
+	unsigned calchash() const override {
+		hashvalue = basic::calchash()+static_cast<unsigned>(index^(index>>32));
+		setflag(status_flags::hash_calculated);
+		return hashvalue;
 	}
 private:
 	void print(const print_context &c, unsigned level) const;	///< Overloaded from basic::print
-	vector<bool> a;	//the sequence epsilon_1,...,epsilon_m; true represents -1, false 1
+	uint64_t index=0;	//the sequence epsilon_1,...,epsilon_m, encoded as the bits of index, starting from the least significant; 1 represents -1, 0 represents 1
+	int m=0;
 };
 
 
@@ -25,6 +25,13 @@
 #include "wedge/base/wedgebase.h"
 #include "wedge/base/expressions.h"
 #include "wedge/base/normalform.h"
+#include "wedge/base/parallel.h"
+#include "wedge/base/persistence.h"
+#include "wedge/base/resultcache.h"
+#include "wedge/base/zerotest.h"
+#include "wedge/base/simplificationcache.h"
+#include "wedge/base/straightlineprogram.h"
+#include "wedge/connections/numericcurvature.h"
 #include "wedge/connections/pseudolevicivita.h"
 #include "wedge/connections/riemannianconnection.h"
 #include "wedge/connections/torsionfreeconnection.h"
@@ -40,18 +47,23 @@
 #include "wedge/liealgebras/liesubgroup.h"
 #include "wedge/liealgebras/su.h"
 #include "wedge/liealgebras/liegrouptostring.h"
+#include "wedge/liealgebras/modularliealgebra.h"
 #include "wedge/linearalgebra/affinebasis.h"
 #include "wedge/linearalgebra/bilinear.h"
 #include "wedge/linearalgebra/bilinearform.h"
 #include "wedge/linearalgebra/derivation.h"
 #include "wedge/linearalgebra/lambda.h"
+#include "wedge/linearalgebra/sparselinearsystem.h"
 #include "wedge/linearalgebra/vectorspace.h"
 #include "wedge/manifolds/concretemanifold.h"
 #include "wedge/manifolds/coordinates.h"
+#include "wedge/manifolds/derivativecache.h"
 #include "wedge/manifolds/liederivative.h"
 #include "wedge/manifolds/manifoldwith.h"
 #include "wedge/polynomialalgebra/cocoapolyalg.h"
 #include "wedge/polynomialalgebra/polybasis.h"
+#include "wedge/polynomialalgebra/sparsepolynomial.h"
+#include "wedge/representations/actionmatrix.h"
 #include "wedge/representations/adjoint.h"
 #include "wedge/representations/gl.h"
 #include "wedge/representations/linearaction.h"